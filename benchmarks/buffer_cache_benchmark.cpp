@@ -0,0 +1,61 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <vector/my_vector.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// Request-loop churn: every iteration builds a few my_vector<uint32_t> of random sizes by push_back and destroys
+// them again. Runs the same sequence with plain ::operator new/delete storage and inside a buffer_cache_scope, and
+// reports the time per iteration and the cache's hit rate.
+// Usage: buffer-cache-benchmark [iterations] [max_elements]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static uint64_t churn(size_t iterations, size_t max_elements) {
+  std::mt19937 rng(9);
+  uint64_t checksum = 0;
+  for (size_t it = 0; it < iterations; ++it) {
+    my_vector<uint32_t> ids;
+    my_vector<uint32_t> scores;
+    const size_t n = 1 + rng() % max_elements;
+    for (size_t i = 0; i < n; ++i) {
+      ids.push_back(static_cast<uint32_t>(i));
+      if (i % 2 == 0)
+        scores.push_back(static_cast<uint32_t>(i * 3));
+    }
+    my_vector<uint32_t> copy(ids);
+    checksum += copy.back() + scores.size();
+  }
+  return checksum;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t iterations = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2'000'000;
+  const size_t max_elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 256;
+  std::cout << iterations << " iterations, up to " << max_elements << " elements per vector\n";
+
+  auto start = std::chrono::steady_clock::now();
+  const uint64_t plain = churn(iterations, max_elements);
+  const double plain_s = seconds_since(start);
+  std::cout << "operator new/delete: " << plain_s / iterations * 1e9 << " ns per iteration\n";
+
+  buffer_cache_scope scope;
+  start = std::chrono::steady_clock::now();
+  const uint64_t cached = churn(iterations, max_elements);
+  const double cached_s = seconds_since(start);
+  const buffer_cache_stats s = buffer_cache_thread_stats();
+  std::cout << "buffer cache       : " << cached_s / iterations * 1e9 << " ns per iteration, hit rate "
+            << 100.0 * static_cast<double>(s.hits) / static_cast<double>(s.hits + s.misses) << "%, "
+            << s.cached_bytes / 1024 << " KiB cached, " << (plain_s - cached_s) / plain_s * 100
+            << "% of the time saved\n";
+  if (plain != cached)
+    std::cout << "checksums differ\n";
+  return 0;
+}
@@ -0,0 +1,92 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <compressed/compressed_int_vector.hpp>
+#include <vector/my_vector.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+// Compression ratio, block-decode scan throughput and random access latency of compressed_int_vector with each
+// encoding, against a plain my_vector<uint64_t> scan, on postings-like data (sorted, small random gaps) and
+// timestamp-like data (sorted, large regular steps with jitter).
+// Usage: compressed-int-vector-benchmark [values]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Encoding> static void measure(const std::string &name, const my_vector<uint64_t> &values) {
+  auto start = std::chrono::steady_clock::now();
+  compressed_int_vector<Encoding> c(values.begin(), values.end());
+  const double build_s = seconds_since(start);
+  c.shrink_to_fit();
+
+  uint64_t sum = 0;
+  my_array<uint64_t, compressed_int_vector<Encoding>::block_size> buffer;
+  start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 5; ++rep) {
+    for (size_t b = 0; b < c.block_count(); ++b) {
+      const size_t n = c.decode_block(b, buffer.data());
+      for (size_t j = 0; j < n; ++j)
+        sum += buffer[j];
+    }
+  }
+  const double scan_s = seconds_since(start) / 5;
+
+  std::mt19937_64 rng(3);
+  const size_t probes = 1'000'000;
+  start = std::chrono::steady_clock::now();
+  for (size_t i = 0; i < probes; ++i)
+    sum += c[rng() % c.size()];
+  const double access_ns = seconds_since(start) / probes * 1e9;
+
+  std::cout << name << ": ratio " << c.compression_ratio() << "x, build " << build_s * 1e3 << " ms, decode "
+            << values.size() / scan_s / 1e6 << " M values/s, random access " << access_ns << " ns"
+            << (sum == 0 ? " (zero sum)" : "") << "\n";
+}
+
+static void plain_scan(const my_vector<uint64_t> &values) {
+  uint64_t sum = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 5; ++rep) {
+    for (uint64_t v : values)
+      sum += v;
+  }
+  const double scan_s = seconds_since(start) / 5;
+  std::cout << "plain my_vector   : ratio 1x, decode " << values.size() / scan_s / 1e6 << " M values/s"
+            << (sum == 0 ? " (zero sum)" : "") << "\n";
+}
+
+static void run(const std::string &dataset, const my_vector<uint64_t> &values) {
+  std::cout << dataset << ", " << values.size() << " values\n";
+  plain_scan(values);
+  measure<for_encoding>("frame of reference", values);
+  measure<delta_varint_encoding>("delta + varint    ", values);
+}
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50'000'000;
+  std::mt19937_64 rng(1);
+  my_vector<uint64_t> values;
+  values.reserve(n);
+
+  uint64_t doc = 0;
+  for (size_t i = 0; i < n; ++i) {
+    doc += 1 + rng() % 64;
+    values.push_back(doc);
+  }
+  run("postings (gaps 1..64)", values);
+
+  values.clear();
+  uint64_t timestamp = 1'700'000'000'000'000;
+  for (size_t i = 0; i < n; ++i) {
+    timestamp += 1'000'000 + rng() % 5'000;
+    values.push_back(timestamp);
+  }
+  run("timestamps (1 ms +- jitter, in ns)", values);
+  return 0;
+}
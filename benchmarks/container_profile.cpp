@@ -0,0 +1,128 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "harness/latency_histogram.hpp"
+#include "harness/perf_counters.hpp"
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Per-operation latency distributions and hardware counters for my_vector operations, printed as JSON.
+// push_back calls that trigger a reallocation are recorded in a separate "reallocation" histogram, because the
+// stalls they cause are exactly what the mean hides.
+// Usage: container-profile [operations]
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+static void print_histogram(const latency_histogram &h) {
+  std::cout << "{\"count\": " << h.count() << ", \"min\": " << h.min() << ", \"mean\": " << h.mean()
+            << ", \"p50\": " << h.percentile(0.5) << ", \"p99\": " << h.percentile(0.99)
+            << ", \"p99_9\": " << h.percentile(0.999) << ", \"max\": " << h.max() << "}";
+}
+
+static void print_counters(const perf_counters &counters) {
+  std::cout << "{";
+  for (size_t c = 0; c < perf_counters::counter_count; ++c) {
+    std::cout << (c ? ", " : "") << "\"" << perf_counters::name(c) << "\": ";
+    if (counters.available(c))
+      std::cout << counters.value(c);
+    else
+      std::cout << "null";
+  }
+  std::cout << "}";
+}
+
+template <typename Body> void run_benchmark(const std::string &name, Body &&body, bool &first) {
+  latency_histogram latency;
+  latency_histogram reallocations;
+  perf_counters counters;
+  counters.start();
+  body(latency, reallocations);
+  counters.stop();
+
+  std::cout << (first ? "" : ",\n") << "    {\"name\": \"" << name << "\", \"latency_ns\": ";
+  print_histogram(latency);
+  if (reallocations.count()) {
+    std::cout << ", \"reallocation_ns\": ";
+    print_histogram(reallocations);
+  }
+  std::cout << ", \"counters\": ";
+  print_counters(counters);
+  std::cout << "}";
+  first = false;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+  const size_t middle_ops = std::min<size_t>(n, 20'000);
+  bool first = true;
+
+  std::cout << "{\n  \"operations\": " << n << ",\n  \"benchmarks\": [\n";
+
+  run_benchmark(
+      "push_back",
+      [n](latency_histogram &latency, latency_histogram &reallocations) {
+        my_vector<uint64_t> v;
+        for (size_t i = 0; i < n; ++i) {
+          const size_t capacity = v.capacity();
+          const uint64_t start = now_ns();
+          v.push_back(i);
+          const uint64_t elapsed = now_ns() - start;
+          latency.record(elapsed);
+          if (v.capacity() != capacity)
+            reallocations.record(elapsed);
+        }
+      },
+      first);
+
+  run_benchmark(
+      "push_back_reserved",
+      [n](latency_histogram &latency, latency_histogram &) {
+        my_vector<uint64_t> v;
+        v.reserve(n);
+        for (size_t i = 0; i < n; ++i) {
+          const uint64_t start = now_ns();
+          v.push_back(i);
+          latency.record(now_ns() - start);
+        }
+      },
+      first);
+
+  run_benchmark(
+      "insert_middle",
+      [middle_ops](latency_histogram &latency, latency_histogram &reallocations) {
+        my_vector<uint64_t> v;
+        for (size_t i = 0; i < middle_ops; ++i) {
+          const size_t capacity = v.capacity();
+          const uint64_t start = now_ns();
+          v.insert(v.begin() + v.size() / 2, i);
+          const uint64_t elapsed = now_ns() - start;
+          latency.record(elapsed);
+          if (v.capacity() != capacity)
+            reallocations.record(elapsed);
+        }
+      },
+      first);
+
+  run_benchmark(
+      "erase_middle",
+      [middle_ops](latency_histogram &latency, latency_histogram &) {
+        my_vector<uint64_t> v(middle_ops);
+        while (!v.is_empty()) {
+          const uint64_t start = now_ns();
+          v.erase(v.begin() + v.size() / 2);
+          latency.record(now_ns() - start);
+        }
+      },
+      first);
+
+  std::cout << "\n  ]\n}\n";
+  return 0;
+}
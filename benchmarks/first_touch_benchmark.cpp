@@ -0,0 +1,64 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <vector/my_vector.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Construction time of a large my_vector<double> built serially and with each placement policy, followed by a
+// parallel read sweep over it using the same chunking, which shows where the pages ended up.
+// Usage: first-touch-benchmark [elements] [threads]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+static double sweep_gb_per_s(const my_vector<double> &v, unsigned threads) {
+  std::atomic<double> total{0.0};
+  auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < 3; ++rep) {
+    parallel_for(v.size(), threads, [&](size_t begin, size_t end, size_t) {
+      double sum = 0;
+      for (size_t i = begin; i < end; ++i)
+        sum += v[i];
+      total.fetch_add(sum);
+    });
+  }
+  const double elapsed = seconds_since(start);
+  if (total.load() != 0.0)
+    std::cout << "unexpected sum\n";
+  return 3.0 * v.size() * sizeof(double) / elapsed / 1e9;
+}
+
+static void report(const std::string &name, const my_vector<double> &v, double construct_s, unsigned threads) {
+  std::cout << name << ": construct " << construct_s * 1e3 << " ms, parallel sweep " << sweep_gb_per_s(v, threads)
+            << " GB/s\n";
+}
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 256'000'000;
+  parallel_init init;
+  if (argc > 2)
+    init.threads = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+  const unsigned threads = parallel_thread_count(n, sizeof(double), init);
+  std::cout << n << " doubles (" << n * sizeof(double) / (1 << 20) << " MiB), " << threads << " threads\n";
+
+  {
+    auto start = std::chrono::steady_clock::now();
+    my_vector<double> v(n);
+    report("serial          ", v, seconds_since(start), threads);
+  }
+  const std::pair<const char *, numa_placement> policies[] = {{"parallel local  ", numa_placement::local},
+                                                              {"parallel interlv", numa_placement::interleave},
+                                                              {"parallel bind 0 ", numa_placement::bind}};
+  for (const auto &[name, placement] : policies) {
+    init.placement = placement;
+    auto start = std::chrono::steady_clock::now();
+    my_vector<double> v(n, init);
+    report(name, v, seconds_since(start), threads);
+  }
+  return 0;
+}
@@ -0,0 +1,66 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <flat/flat_set.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+
+// Lookup throughput of std::map, std::lower_bound over a sorted my_vector and flat_set with both search layouts.
+// Usage: flat-lookup-benchmark [table_size] [lookups]
+
+template <typename F> double lookups_per_second(const my_vector<uint32_t> &queries, F &&lookup) {
+  uint64_t found = 0;
+  auto start = std::chrono::high_resolution_clock::now();
+  for (const auto q : queries)
+    found += lookup(q);
+  auto end = std::chrono::high_resolution_clock::now();
+  const double seconds = std::chrono::duration<double>(end - start).count();
+  // Keeps the loop from being optimised out.
+  if (found == static_cast<uint64_t>(-1))
+    std::cout << found;
+  return queries.size() / seconds;
+}
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1'000'000;
+  const size_t lookups = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5'000'000;
+
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> dist;
+  my_vector<uint32_t> keys;
+  keys.reserve(n);
+  for (size_t i = 0; i < n; ++i)
+    keys.push_back(dist(gen));
+  my_vector<uint32_t> queries;
+  queries.reserve(lookups);
+  for (size_t i = 0; i < lookups; ++i)
+    queries.push_back(i % 2 ? keys[dist(gen) % n] : dist(gen));
+
+  std::map<uint32_t, uint32_t> tree;
+  for (const auto k : keys)
+    tree.emplace(k, k);
+  my_vector<uint32_t> sorted(keys);
+  std::sort(sorted.begin(), sorted.end());
+  flat_set<uint32_t, std::less<uint32_t>, sorted_layout> branchless(keys.begin(), keys.end());
+  flat_set<uint32_t, std::less<uint32_t>, eytzinger_layout> eytzinger(keys.begin(), keys.end());
+
+  const double map_rate = lookups_per_second(queries, [&](uint32_t q) { return tree.find(q) != tree.end(); });
+  const double lower_bound_rate = lookups_per_second(queries, [&](uint32_t q) {
+    const uint32_t *it = std::lower_bound(sorted.begin(), sorted.end(), q);
+    return it != sorted.end() && *it == q;
+  });
+  const double branchless_rate = lookups_per_second(queries, [&](uint32_t q) { return branchless.contains(q); });
+  const double eytzinger_rate = lookups_per_second(queries, [&](uint32_t q) { return eytzinger.contains(q); });
+
+  std::cout << "table size " << n << ", " << lookups << " lookups (Mlookups/s)\n"
+            << "std::map                      " << map_rate / 1e6 << "\n"
+            << "sorted my_vector lower_bound  " << lower_bound_rate / 1e6 << "\n"
+            << "flat_set sorted_layout        " << branchless_rate / 1e6 << "\n"
+            << "flat_set eytzinger_layout     " << eytzinger_rate / 1e6 << "\n";
+  return 0;
+}
@@ -0,0 +1,78 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <gap_buffer/gap_buffer.hpp>
+#include <vector/my_vector.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+
+// Cursor-local editing of a char32_t text: a cursor wanders a few characters at a time through the buffer, and at
+// each stop types or deletes a character, with an occasional jump to a random place. Runs the same edit sequence on
+// my_vector<char32_t> insert/erase and on gap_buffer<char32_t>, then reads the result once through segments and
+// once through contiguous().
+// Usage: gap-buffer-benchmark [size] [edits]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename Buffer> static void edit(Buffer &text, size_t edits) {
+  std::mt19937 rng(11);
+  size_t cursor = text.size() / 2;
+  for (size_t i = 0; i < edits; ++i) {
+    if (rng() % 1000 == 0) {
+      cursor = rng() % (text.size() + 1);
+    } else {
+      const size_t step = rng() % 8;
+      cursor = rng() % 2 ? std::min(cursor + step, text.size()) : cursor - std::min(cursor, step);
+    }
+    if (rng() % 4 != 0) {
+      text.insert(text.begin() + cursor, static_cast<char32_t>(U'a' + i % 26));
+      ++cursor;
+    } else if (cursor < text.size()) {
+      text.erase(text.begin() + cursor);
+    }
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const size_t size = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4'000'000;
+  const size_t edits = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20'000;
+  std::cout << size << " characters, " << edits << " cursor-local edits\n";
+
+  my_vector<char32_t> vector_text(size, U' ');
+  auto start = std::chrono::steady_clock::now();
+  edit(vector_text, edits);
+  const double vector_s = seconds_since(start);
+  std::cout << "my_vector  : " << vector_s / static_cast<double>(edits) * 1e9 << " ns per edit\n";
+
+  gap_buffer<char32_t> gap_text(size, U' ');
+  start = std::chrono::steady_clock::now();
+  edit(gap_text, edits);
+  const double gap_s = seconds_since(start);
+  std::cout << "gap_buffer : " << gap_s / static_cast<double>(edits) * 1e9 << " ns per edit, " << vector_s / gap_s
+            << "x faster\n";
+
+  uint64_t checksum = 0;
+  start = std::chrono::steady_clock::now();
+  gap_text.for_each_segment([&](const char32_t *first, const char32_t *last) {
+    for (; first != last; ++first)
+      checksum += *first;
+  });
+  std::cout << "segment scan   : " << seconds_since(start) * 1e3 << " ms\n";
+
+  start = std::chrono::steady_clock::now();
+  const my_span<char32_t> all = gap_text.contiguous();
+  std::cout << "close the gap  : " << seconds_since(start) * 1e3 << " ms\n";
+
+  uint64_t expected = 0;
+  for (char32_t c : vector_text)
+    expected += c;
+  if (checksum != expected || all.size() != vector_text.size() ||
+      !std::equal(all.begin(), all.end(), vector_text.begin()))
+    std::cout << "results differ\n";
+  return 0;
+}
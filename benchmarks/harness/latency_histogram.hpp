@@ -0,0 +1,94 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef LATENCY_HISTOGRAM_HPP
+#define LATENCY_HISTOGRAM_HPP
+
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+// Log-linear (HDR-style) histogram of nanosecond latencies. Values below 128 get exact buckets; above that every
+// power-of-two range is split into 64 sub-buckets, so any recorded value is reported within 1/64 (~1.6%) of its
+// true size while the whole 64-bit range fits in a fixed 3776-entry table and recording is O(1).
+class latency_histogram {
+public:
+  static constexpr unsigned sub_bucket_bits = 6;
+  static constexpr uint64_t sub_buckets = uint64_t{1} << sub_bucket_bits;
+  static constexpr size_t bucket_count = 2 * sub_buckets + (64 - sub_bucket_bits - 1) * sub_buckets;
+
+  latency_histogram() : _counts(bucket_count, 0) {}
+
+  void record(uint64_t value) noexcept {
+    ++_counts[index_of(value)];
+    ++_total;
+    _sum += value;
+    _min = std::min(_min, value);
+    _max = std::max(_max, value);
+  }
+
+  void merge(const latency_histogram &other) noexcept {
+    for (size_t i = 0; i < bucket_count; ++i)
+      _counts[i] += other._counts[i];
+    _total += other._total;
+    _sum += other._sum;
+    _min = std::min(_min, other._min);
+    _max = std::max(_max, other._max);
+  }
+
+  void reset() noexcept {
+    std::fill(_counts.begin(), _counts.end(), 0);
+    _total = 0;
+    _sum = 0;
+    _min = std::numeric_limits<uint64_t>::max();
+    _max = 0;
+  }
+
+  uint64_t count() const noexcept { return _total; }
+
+  uint64_t min() const noexcept { return _total ? _min : 0; }
+
+  uint64_t max() const noexcept { return _max; }
+
+  double mean() const noexcept { return _total ? static_cast<double>(_sum) / _total : 0.0; }
+
+  // Smallest bucket upper bound that covers the given fraction (0..1] of the samples, clamped to the exact max.
+  uint64_t percentile(double fraction) const noexcept {
+    if (_total == 0)
+      return 0;
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(fraction * _total + 0.5));
+    uint64_t seen = 0;
+    for (size_t i = 0; i < bucket_count; ++i) {
+      seen += _counts[i];
+      if (seen >= rank)
+        return std::min(highest_equivalent(i), _max);
+    }
+    return _max;
+  }
+
+private:
+  static size_t index_of(uint64_t value) noexcept {
+    if (value < 2 * sub_buckets)
+      return value;
+    const unsigned shift = std::bit_width(value) - 1 - sub_bucket_bits;
+    return 2 * sub_buckets + (shift - 1) * sub_buckets + ((value >> shift) - sub_buckets);
+  }
+
+  static uint64_t highest_equivalent(size_t index) noexcept {
+    if (index < 2 * sub_buckets)
+      return index;
+    const size_t rest = index - 2 * sub_buckets;
+    const unsigned shift = rest / sub_buckets + 1;
+    const uint64_t lowest = (sub_buckets + rest % sub_buckets) << shift;
+    return lowest + ((uint64_t{1} << shift) - 1);
+  }
+
+  my_vector<uint64_t> _counts;
+  uint64_t _total = 0;
+  uint64_t _sum = 0;
+  uint64_t _min = std::numeric_limits<uint64_t>::max();
+  uint64_t _max = 0;
+};
+
+#endif // LATENCY_HISTOGRAM_HPP
@@ -0,0 +1,99 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef PERF_COUNTERS_HPP
+#define PERF_COUNTERS_HPP
+
+#include <array/my_array.hpp>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Per-benchmark hardware and software counters through Linux perf_event_open. Each counter is opened on its own,
+// for the calling thread, user space only; a counter the kernel refuses (no PMU in a VM, perf_event_paranoid, a
+// non-Linux build) is simply reported as unavailable instead of failing the run.
+class perf_counters {
+public:
+  enum counter : size_t { cycles, instructions, cache_misses, page_faults, counter_count };
+
+  static constexpr const char *name(size_t c) noexcept {
+    constexpr const char *names[] = {"cycles", "instructions", "cache_misses", "page_faults"};
+    return names[c];
+  }
+
+  perf_counters() : _fds(-1), _values(0) {
+#if defined(__linux__)
+    _fds[cycles] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES);
+    _fds[instructions] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS);
+    _fds[cache_misses] = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+    _fds[page_faults] = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+#endif
+  }
+
+  perf_counters(const perf_counters &) = delete;
+
+  perf_counters &operator=(const perf_counters &) = delete;
+
+  ~perf_counters() {
+#if defined(__linux__)
+    for (const int fd : _fds) {
+      if (fd >= 0)
+        close(fd);
+    }
+#endif
+  }
+
+  bool available(size_t c) const noexcept { return _fds[c] >= 0; }
+
+  void start() noexcept {
+#if defined(__linux__)
+    for (const int fd : _fds) {
+      if (fd >= 0) {
+        ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+      }
+    }
+#endif
+  }
+
+  void stop() noexcept {
+#if defined(__linux__)
+    for (size_t c = 0; c < counter_count; ++c) {
+      _values[c] = 0;
+      if (_fds[c] < 0)
+        continue;
+      ioctl(_fds[c], PERF_EVENT_IOC_DISABLE, 0);
+      uint64_t value = 0;
+      if (read(_fds[c], &value, sizeof(value)) == static_cast<ssize_t>(sizeof(value)))
+        _values[c] = value;
+    }
+#endif
+  }
+
+  uint64_t value(size_t c) const noexcept { return _values[c]; }
+
+private:
+#if defined(__linux__)
+  static int open_counter(uint32_t type, uint64_t config) noexcept {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = type;
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    return static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+  }
+#endif
+
+  my_array<int, counter_count> _fds;
+  my_array<uint64_t, counter_count> _values;
+};
+
+#endif // PERF_COUNTERS_HPP
@@ -0,0 +1,88 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <mdarray/md_kernels.hpp>
+#include <mdarray/mdarray.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+// Transposes an n x n float matrix naively (one pass over the source rows, column-strided stores) and with the
+// cache-blocked kernel, then runs a 5-point stencil sweep in row-major loop order over row-major, column-major and
+// blocked storage of the same matrix.
+// Usage: mdarray-benchmark [n]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+template <typename SrcLayout, typename DstLayout>
+static void naive_transpose(const md_view<const float, SrcLayout, 2> &src, const md_view<float, DstLayout, 2> &dst) {
+  for (size_t i = 0; i < src.extent(0); ++i) {
+    for (size_t j = 0; j < src.extent(1); ++j)
+      dst(j, i) = src(i, j);
+  }
+}
+
+template <typename Layout>
+static float stencil(const md_view<const float, Layout, 2> &in, const md_view<float, Layout, 2> &out) {
+  float checksum = 0;
+  for (size_t i = 1; i + 1 < in.extent(0); ++i) {
+    for (size_t j = 1; j + 1 < in.extent(1); ++j) {
+      out(i, j) = 0.2f * (in(i, j) + in(i - 1, j) + in(i + 1, j) + in(i, j - 1) + in(i, j + 1));
+      checksum += out(i, j);
+    }
+  }
+  return checksum;
+}
+
+template <typename F> static void report(const std::string &name, size_t n, int reps, F &&run) {
+  run();
+  auto start = std::chrono::steady_clock::now();
+  for (int rep = 0; rep < reps; ++rep)
+    run();
+  const double per_run = seconds_since(start) / reps;
+  std::cout << name << ": " << per_run * 1e3 << " ms, " << 2.0 * n * n * sizeof(float) / per_run / 1e9 << " GB/s\n";
+}
+
+template <typename Layout> static void stencil_case(const std::string &name, size_t n, int reps) {
+  dynamic_mdarray<float, 2, Layout> in(my_array<size_t, 2>(n, n));
+  dynamic_mdarray<float, 2, Layout> out(my_array<size_t, 2>(n, n));
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j)
+      in(i, j) = static_cast<float>((i * 31 + j * 17) % 101);
+  }
+  float checksum = 0;
+  report(name, n, reps, [&] { checksum += stencil<Layout>(in.view(), out.view()); });
+  if (checksum < 0)
+    std::cout << "unexpected checksum\n";
+}
+
+int main(int argc, char *argv[]) {
+  const size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4096;
+  const int reps = 5;
+  std::cout << n << " x " << n << " floats (" << n * n * sizeof(float) / (1 << 20) << " MiB)\n";
+
+  dynamic_mdarray<float, 2> src(my_array<size_t, 2>(n, n));
+  for (size_t i = 0; i < n; ++i) {
+    for (size_t j = 0; j < n; ++j)
+      src(i, j) = static_cast<float>(i * n + j);
+  }
+  const auto &csrc = src;
+  dynamic_mdarray<float, 2> dst(my_array<size_t, 2>(n, n));
+  dynamic_mdarray<float, 2, layout_blocked<16>> tiled_src(my_array<size_t, 2>(n, n));
+  dynamic_mdarray<float, 2, layout_blocked<16>> tiled_dst(my_array<size_t, 2>(n, n));
+  md_copy(csrc.view(), tiled_src.view());
+  const auto &ctiled_src = tiled_src;
+
+  report("transpose naive        ", n, reps, [&] { naive_transpose(csrc.view(), dst.view()); });
+  report("transpose blocked 16   ", n, reps, [&] { md_transpose<16>(csrc.view(), dst.view()); });
+  report("transpose blocked 32   ", n, reps, [&] { md_transpose<32>(csrc.view(), dst.view()); });
+  report("transpose tiled layout ", n, reps, [&] { md_transpose<16>(ctiled_src.view(), tiled_dst.view()); });
+
+  stencil_case<layout_right>("stencil row-major      ", n, reps);
+  stencil_case<layout_left>("stencil column-major   ", n, reps);
+  stencil_case<layout_blocked<16>>("stencil blocked 16     ", n, reps);
+  return 0;
+}
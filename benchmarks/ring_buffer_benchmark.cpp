@@ -0,0 +1,149 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include "harness/latency_histogram.hpp"
+#include <concurrent/mpmc_ring.hpp>
+#include <concurrent/spsc_ring.hpp>
+#include <vector/my_vector.hpp>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+
+// One producer hands timestamped items to one consumer through each queue. Reports throughput and the
+// distribution of enqueue-to-dequeue latency. The baseline is the mutex-guarded my_vector the rings replace: the
+// producer appends under the lock, the consumer swaps the whole vector out under the lock.
+// Usage: ring-buffer-benchmark [items]
+
+constexpr size_t ring_size = 4096;
+constexpr size_t batch = 32;
+
+static uint64_t now_ns() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+struct mutex_queue {
+  bool try_push(uint64_t value) {
+    std::lock_guard<std::mutex> lock(mutex);
+    items.push_back(value);
+    return true;
+  }
+
+  size_t push_n(const uint64_t *values, size_t count) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < count; ++i)
+      items.push_back(values[i]);
+    return count;
+  }
+
+  void drain(my_vector<uint64_t> &out) {
+    out.clear();
+    std::lock_guard<std::mutex> lock(mutex);
+    items.swap(out);
+  }
+
+  std::mutex mutex;
+  my_vector<uint64_t> items;
+};
+
+template <typename Producer, typename Consumer>
+void run(const std::string &name, size_t items, Producer &&produce, Consumer &&consume) {
+  latency_histogram latency;
+  auto start = std::chrono::steady_clock::now();
+  std::thread producer([&] { produce(items); });
+  consume(items, latency);
+  producer.join();
+  const double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  std::cout << name << ": " << items / seconds / 1e6 << " Mitems/s, latency p50 " << latency.percentile(0.5)
+            << " ns, p99 " << latency.percentile(0.99) << " ns, max " << latency.max() << " ns\n";
+}
+
+template <typename Queue> void single_item_producer(Queue &queue, size_t items) {
+  for (size_t i = 0; i < items;) {
+    if (queue.try_push(now_ns()))
+      ++i;
+    else
+      std::this_thread::yield();
+  }
+}
+
+template <typename Queue> void batch_producer(Queue &queue, size_t items) {
+  uint64_t values[batch];
+  for (size_t i = 0; i < items;) {
+    const size_t n = std::min(batch, items - i);
+    const uint64_t ts = now_ns();
+    for (size_t j = 0; j < n; ++j)
+      values[j] = ts;
+    const size_t pushed = queue.push_n(values, n);
+    i += pushed;
+    if (pushed < n)
+      std::this_thread::yield();
+  }
+}
+
+template <typename Queue> void single_item_consumer(Queue &queue, size_t items, latency_histogram &latency) {
+  for (size_t received = 0; received < items;) {
+    uint64_t ts;
+    if (queue.try_pop(ts)) {
+      latency.record(now_ns() - ts);
+      ++received;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+}
+
+template <typename Queue> void batch_consumer(Queue &queue, size_t items, latency_histogram &latency) {
+  uint64_t values[batch];
+  for (size_t received = 0; received < items;) {
+    const size_t n = queue.pop_n(values, batch);
+    const uint64_t now = now_ns();
+    for (size_t j = 0; j < n; ++j)
+      latency.record(now - values[j]);
+    received += n;
+    if (n == 0)
+      std::this_thread::yield();
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const size_t items = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10'000'000;
+
+  {
+    mutex_queue queue;
+    auto drain = [&](size_t n, latency_histogram &latency) {
+      my_vector<uint64_t> local;
+      for (size_t received = 0; received < n;) {
+        queue.drain(local);
+        const uint64_t now = now_ns();
+        for (const auto ts : local)
+          latency.record(now - ts);
+        received += local.size();
+        if (local.is_empty())
+          std::this_thread::yield();
+      }
+    };
+    run("mutex + my_vector       ", items, [&](size_t n) { single_item_producer(queue, n); }, drain);
+    run("mutex + my_vector batch ", items, [&](size_t n) { batch_producer(queue, n); }, drain);
+  }
+  {
+    auto ring = std::make_unique<spsc_ring<uint64_t, ring_size>>();
+    run("spsc_ring               ", items, [&](size_t n) { single_item_producer(*ring, n); },
+        [&](size_t n, latency_histogram &latency) { single_item_consumer(*ring, n, latency); });
+    run("spsc_ring batch         ", items, [&](size_t n) { batch_producer(*ring, n); },
+        [&](size_t n, latency_histogram &latency) { batch_consumer(*ring, n, latency); });
+  }
+  {
+    auto ring = std::make_unique<mpmc_ring<uint64_t, ring_size>>();
+    run("mpmc_ring               ", items, [&](size_t n) { single_item_producer(*ring, n); },
+        [&](size_t n, latency_histogram &latency) { single_item_consumer(*ring, n, latency); });
+    run("mpmc_ring batch         ", items, [&](size_t n) { batch_producer(*ring, n); },
+        [&](size_t n, latency_histogram &latency) { batch_consumer(*ring, n, latency); });
+  }
+  return 0;
+}
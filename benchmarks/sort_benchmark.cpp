@@ -0,0 +1,72 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+
+#include <sort/radix_sort.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+
+// std::sort against radix_sort (with one scratch buffer reused over all repetitions) and parallel_radix_sort on
+// random my_vector<uint64_t> and my_vector<std::pair<uint32_t, uint32_t>>, for 1K elements up to max_elements in
+// steps of 10x. The full 1K..1B range needs max_elements = 1000000000 and about 20 GB of memory for the uint64_t
+// case (input, working copy and scratch).
+// Usage: sort-benchmark [max_elements] [threads]
+
+static double seconds_since(std::chrono::steady_clock::time_point start) {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+// Nanoseconds per element for sorting a fresh copy of input, averaged over enough repetitions to run ~10M elements.
+template <typename T, typename Sort> static double ns_per_element(const my_vector<T> &input, Sort &&sort) {
+  const size_t n = input.size();
+  const size_t reps = std::max<size_t>(1, 10'000'000 / n);
+  my_vector<T> work(n);
+  double total = 0;
+  for (size_t rep = 0; rep < reps; ++rep) {
+    std::copy(input.begin(), input.end(), work.begin());
+    auto start = std::chrono::steady_clock::now();
+    sort(work);
+    total += seconds_since(start);
+  }
+  if (!std::is_sorted(work.begin(), work.end()))
+    std::cout << "not sorted\n";
+  return total / reps / n * 1e9;
+}
+
+template <typename T, typename Gen>
+static void run(const std::string &name, size_t max_n, const parallel_init &init, Gen gen) {
+  std::cout << name << " (ns per element)\n";
+  std::mt19937_64 rng(1);
+  for (size_t n = 1000; n <= max_n; n *= 10) {
+    my_vector<T> input;
+    input.reserve(n);
+    for (size_t i = 0; i < n; ++i)
+      input.push_back(gen(rng));
+    my_vector<T> scratch;
+    const double std_ns = ns_per_element(input, [](my_vector<T> &v) { std::sort(v.begin(), v.end()); });
+    const double radix_ns = ns_per_element(input, [&](my_vector<T> &v) { radix_sort(v, scratch); });
+    const double parallel_ns = ns_per_element(input, [&](my_vector<T> &v) { parallel_radix_sort(v, scratch, init); });
+    std::cout << "  n = " << n << ": std::sort " << std_ns << ", radix_sort " << radix_ns << ", parallel_radix_sort "
+              << parallel_ns << "\n";
+  }
+}
+
+int main(int argc, char *argv[]) {
+  const size_t max_n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100'000'000;
+  parallel_init init;
+  if (argc > 2)
+    init.threads = static_cast<unsigned>(std::strtoul(argv[2], nullptr, 10));
+  std::cout << "up to " << max_n << " elements, up to " << init.threads << " threads\n";
+  run<uint64_t>("uint64_t", max_n, init, [](auto &rng) { return rng(); });
+  run<std::pair<uint32_t, uint32_t>>("pair<uint32_t, uint32_t>", max_n, init, [](auto &rng) {
+    const uint64_t x = rng();
+    return std::pair<uint32_t, uint32_t>(static_cast<uint32_t>(x >> 32), static_cast<uint32_t>(x));
+  });
+  return 0;
+}
@@ -1,5 +1,7 @@
 #ifndef MY_ARRAY_HPP
 #define MY_ARRAY_HPP
+#include <parallel/first_touch.hpp>
+#include <span/my_span.hpp>
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
@@ -21,7 +23,17 @@ public:
     }
   }
 
-  template <typename... U, typename = std::enable_if_t<sizeof...(U) == N>>
+  // Fill constructor for very large arrays: chunks are written by parallel threads, so each thread touches its
+  // chunk's pages first. Only for elements whose default construction leaves the memory untouched; an explicit
+  // init.placement is not applied, since the array shares its pages with whatever surrounds it.
+  my_array(const T &value, const parallel_init &init)
+    requires std::is_trivially_default_constructible_v<T>
+  {
+    fill(value, init);
+  }
+
+  template <typename... U,
+            typename = std::enable_if_t<sizeof...(U) == N && (std::is_convertible_v<U &&, T> && ...)>>
   explicit constexpr my_array(U&&... elems)
     : _data{  std::forward<U>(elems)...  } {}
 
@@ -61,6 +73,10 @@ public:
 
   constexpr const T *data() const noexcept { return _data; }
 
+  operator my_span<T>() noexcept { return my_span<T>(_data, N); }
+
+  constexpr operator my_span<const T>() const noexcept { return my_span<const T>(_data, N); }
+
   void fill(const T &value) {
     if constexpr (std::is_trivially_copyable_v<T>) {
       fill_trivial(value);
@@ -70,6 +86,13 @@ public:
     }
   }
 
+  // Assigns value in parallel chunks; see the parallel fill constructor.
+  void fill(const T &value, const parallel_init &init) {
+    parallel_for(N, parallel_thread_count(N, sizeof(T), init), [this, &value](size_t begin, size_t end, size_t) {
+      std::fill(_data + begin, _data + end, value);
+    });
+  }
+
   void swap(my_array &other) noexcept(noexcept(std::swap(std::declval<T &>(), std::declval<T &>()))) {
     for (std::size_t i = 0; i < N; ++i)
       std::swap(_data[i], other._data[i]);
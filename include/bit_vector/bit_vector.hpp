@@ -0,0 +1,285 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef BIT_VECTOR_HPP
+#define BIT_VECTOR_HPP
+
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+
+// Dynamic bitset packed into 64-bit words. Bits past size() in the last word are always kept zero, so word-level
+// operations (count, find, bulk logic) never need to mask anything but the tail on resize.
+class bit_vector {
+public:
+  static constexpr size_t npos = static_cast<size_t>(-1);
+  static constexpr size_t word_bits = 64;
+
+  class reference {
+  public:
+    reference(uint64_t *word, uint64_t mask) noexcept : _word(word), _mask(mask) {}
+
+    reference(const reference &) = default;
+
+    operator bool() const noexcept { return (*_word & _mask) != 0; }
+
+    reference &operator=(bool value) noexcept {
+      if (value)
+        *_word |= _mask;
+      else
+        *_word &= ~_mask;
+      return *this;
+    }
+
+    reference &operator=(const reference &other) noexcept { return *this = static_cast<bool>(other); }
+
+    void flip() noexcept { *_word ^= _mask; }
+
+  private:
+    uint64_t *_word;
+    uint64_t _mask;
+  };
+
+  bit_vector() : _size(0) {}
+
+  explicit bit_vector(size_t n, bool value = false)
+      : _words(words_for(n), value ? ~uint64_t{0} : uint64_t{0}), _size(n) {
+    clear_tail();
+  }
+
+  size_t size() const noexcept { return _size; }
+
+  bool is_empty() const noexcept { return _size == 0; }
+
+  size_t capacity() const { return _words.capacity() * word_bits; }
+
+  const my_vector<uint64_t> &words() const noexcept { return _words; }
+
+  reference operator[](size_t index) noexcept {
+    return reference(&_words[index / word_bits], uint64_t{1} << (index % word_bits));
+  }
+
+  bool operator[](size_t index) const noexcept { return test(index); }
+
+  reference at(size_t index) {
+    if (index >= _size)
+      throw std::out_of_range("Index out of range");
+    return (*this)[index];
+  }
+
+  bool at(size_t index) const {
+    if (index >= _size)
+      throw std::out_of_range("Index out of range");
+    return test(index);
+  }
+
+  bool test(size_t index) const noexcept { return (_words[index / word_bits] >> (index % word_bits)) & 1; }
+
+  void set(size_t index) noexcept { _words[index / word_bits] |= uint64_t{1} << (index % word_bits); }
+
+  void set(size_t index, bool value) noexcept { (*this)[index] = value; }
+
+  void reset(size_t index) noexcept { _words[index / word_bits] &= ~(uint64_t{1} << (index % word_bits)); }
+
+  void flip(size_t index) noexcept { _words[index / word_bits] ^= uint64_t{1} << (index % word_bits); }
+
+  void set_all() noexcept {
+    std::fill(_words.begin(), _words.end(), ~uint64_t{0});
+    clear_tail();
+  }
+
+  void reset_all() noexcept { std::fill(_words.begin(), _words.end(), uint64_t{0}); }
+
+  void reserve(size_t n) { _words.reserve(words_for(n)); }
+
+  void push_back(bool value) {
+    if (_size % word_bits == 0)
+      _words.push_back(0);
+    ++_size;
+    set(_size - 1, value);
+  }
+
+  void pop_back() {
+    if (_size == 0)
+      return;
+    reset(--_size);
+    if (_size % word_bits == 0)
+      _words.pop_back();
+  }
+
+  void resize(size_t n, bool value = false) {
+    const size_t old_size = _size;
+    if (n > old_size && value && old_size % word_bits != 0)
+      _words.back() |= ~uint64_t{0} << (old_size % word_bits);
+    const size_t old_words = _words.size();
+    _words.resize(words_for(n));
+    if (value)
+      std::fill(_words.begin() + std::min(old_words, _words.size()), _words.end(), ~uint64_t{0});
+    _size = n;
+    clear_tail();
+  }
+
+  void clear() noexcept {
+    _words.clear();
+    _size = 0;
+  }
+
+  // Population count, one word at a time.
+  size_t count() const noexcept {
+    size_t total = 0;
+    for (const uint64_t w : _words)
+      total += std::popcount(w);
+    return total;
+  }
+
+  bool any() const noexcept {
+    return std::any_of(_words.begin(), _words.end(), [](uint64_t w) { return w != 0; });
+  }
+
+  bool none() const noexcept { return !any(); }
+
+  bool all() const noexcept { return count() == _size; }
+
+  size_t find_first() const noexcept { return scan_from_word(0); }
+
+  // Position of the first set bit strictly after pos, or npos.
+  size_t find_next(size_t pos) const noexcept {
+    ++pos;
+    if (pos >= _size)
+      return npos;
+    const size_t w = pos / word_bits;
+    const uint64_t rest = _words[w] & (~uint64_t{0} << (pos % word_bits));
+    if (rest)
+      return w * word_bits + std::countr_zero(rest);
+    return scan_from_word(w + 1);
+  }
+
+  // Bulk logic runs over the raw word arrays; the loops have no cross-iteration dependencies and are vectorised by
+  // the compiler (SSE2 by default, AVX2/AVX-512 when the target allows it).
+  bit_vector &operator&=(const bit_vector &other) {
+    combine(other, [](uint64_t a, uint64_t b) { return a & b; });
+    return *this;
+  }
+
+  bit_vector &operator|=(const bit_vector &other) {
+    combine(other, [](uint64_t a, uint64_t b) { return a | b; });
+    return *this;
+  }
+
+  bit_vector &operator^=(const bit_vector &other) {
+    combine(other, [](uint64_t a, uint64_t b) { return a ^ b; });
+    return *this;
+  }
+
+  bit_vector &and_not(const bit_vector &other) {
+    combine(other, [](uint64_t a, uint64_t b) { return a & ~b; });
+    return *this;
+  }
+
+  friend bit_vector operator&(bit_vector lhs, const bit_vector &rhs) { return lhs &= rhs; }
+
+  friend bit_vector operator|(bit_vector lhs, const bit_vector &rhs) { return lhs |= rhs; }
+
+  friend bit_vector operator^(bit_vector lhs, const bit_vector &rhs) { return lhs ^= rhs; }
+
+  void swap(bit_vector &other) noexcept {
+    _words.swap(other._words);
+    std::swap(_size, other._size);
+  }
+
+  bool operator==(const bit_vector &other) const { return _size == other._size && _words == other._words; }
+
+  bool operator!=(const bit_vector &other) const { return !(*this == other); }
+
+private:
+  static size_t words_for(size_t bits) noexcept { return (bits + word_bits - 1) / word_bits; }
+
+  void clear_tail() noexcept {
+    if (_size % word_bits != 0)
+      _words.back() &= ~(~uint64_t{0} << (_size % word_bits));
+  }
+
+  size_t scan_from_word(size_t w) const noexcept {
+    for (; w < _words.size(); ++w) {
+      if (_words[w])
+        return w * word_bits + std::countr_zero(_words[w]);
+    }
+    return npos;
+  }
+
+  template <typename Op> void combine(const bit_vector &other, Op op) {
+    if (other._size != _size)
+      throw std::invalid_argument("bit_vector sizes differ");
+    uint64_t *dst = _words.begin();
+    const uint64_t *src = other._words.begin();
+    const size_t n = _words.size();
+    for (size_t i = 0; i < n; ++i)
+      dst[i] = op(dst[i], src[i]);
+  }
+
+  my_vector<uint64_t> _words;
+  size_t _size;
+};
+
+// Rank/select directory over a bit_vector: one cumulative count per 512-bit superblock (1/8 of the bitmap size).
+// It refers to the bit_vector it was built from and has to be rebuilt after that vector changes.
+class rank_select {
+public:
+  static constexpr size_t words_per_block = 8;
+
+  explicit rank_select(const bit_vector &bits) : _bits(&bits) {
+    const my_vector<uint64_t> &words = bits.words();
+    const size_t blocks = (words.size() + words_per_block - 1) / words_per_block;
+    _block_rank.reserve(blocks + 1);
+    size_t total = 0;
+    for (size_t w = 0; w < words.size(); ++w) {
+      if (w % words_per_block == 0)
+        _block_rank.push_back(total);
+      total += std::popcount(words[w]);
+    }
+    _block_rank.push_back(total);
+  }
+
+  // Number of set bits in [0, pos).
+  size_t rank1(size_t pos) const noexcept {
+    const my_vector<uint64_t> &words = _bits->words();
+    const size_t w = pos / bit_vector::word_bits;
+    size_t result = _block_rank[w / words_per_block];
+    for (size_t i = w - w % words_per_block; i < w; ++i)
+      result += std::popcount(words[i]);
+    if (pos % bit_vector::word_bits)
+      result += std::popcount(words[w] & ~(~uint64_t{0} << (pos % bit_vector::word_bits)));
+    return result;
+  }
+
+  size_t rank0(size_t pos) const noexcept { return pos - rank1(pos); }
+
+  // Position of the set bit with the given zero-based ordinal, or bit_vector::npos.
+  size_t select1(size_t nth) const noexcept {
+    if (nth >= _block_rank.back())
+      return bit_vector::npos;
+    const size_t *block = std::upper_bound(_block_rank.begin(), _block_rank.end(), nth) - 1;
+    size_t remaining = nth - *block;
+    const my_vector<uint64_t> &words = _bits->words();
+    for (size_t w = (block - _block_rank.begin()) * words_per_block;; ++w) {
+      const size_t ones = std::popcount(words[w]);
+      if (remaining < ones)
+        return w * bit_vector::word_bits + select_in_word(words[w], remaining);
+      remaining -= ones;
+    }
+  }
+
+private:
+  static size_t select_in_word(uint64_t word, size_t nth) noexcept {
+    for (; nth > 0; --nth)
+      word &= word - 1;
+    return std::countr_zero(word);
+  }
+
+  const bit_vector *_bits;
+  my_vector<size_t> _block_rank;
+};
+
+#endif // BIT_VECTOR_HPP
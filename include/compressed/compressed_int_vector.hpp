@@ -0,0 +1,280 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef COMPRESSED_INT_VECTOR_HPP
+#define COMPRESSED_INT_VECTOR_HPP
+
+#include <array/my_array.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+// Encodings used by compressed_int_vector. Values are encoded in blocks of block_size; every encoded block starts on
+// a word boundary of the shared word stream and is described by a block_header, which is the block's skip pointer:
+// it locates the block without decoding anything before it.
+//
+// An encoding provides
+//   static block_header encode(const uint64_t *values, my_vector<uint64_t> &words);
+//   static void decode(const uint64_t *words, const block_header &header, uint64_t *out);
+//   static uint64_t get(const uint64_t *words, const block_header &header, size_t index);
+
+struct block_header {
+  uint64_t offset : 56; // first word of the block
+  uint64_t width : 8;   // bits per value; unused by delta_varint_encoding
+  uint64_t base;        // frame of reference, or the first value of the block
+};
+
+namespace compressed_detail {
+constexpr size_t block_size = 128;
+
+inline block_header make_header(size_t offset, unsigned width, uint64_t base) noexcept {
+  block_header header;
+  header.offset = offset;
+  header.width = width;
+  header.base = base;
+  return header;
+}
+
+// Appends n zeroed words and returns the first. resize() alone would reallocate to the exact size every block.
+inline uint64_t *append_words(my_vector<uint64_t> &words, size_t n) {
+  const size_t first = words.size();
+  if (first + n > words.capacity())
+    words.reserve(std::max(first + n, 2 * words.capacity()));
+  words.resize(first + n);
+  return words.data() + first;
+}
+
+// Unpacks one block of W-bit values stored back to back from bit 0 of in, adding base to each.
+template <unsigned W> void unpack(const uint64_t *in, uint64_t base, uint64_t *out) {
+  constexpr uint64_t mask = W == 64 ? ~uint64_t{0} : (uint64_t{1} << W) - 1;
+  for (size_t j = 0; j < block_size; ++j) {
+    if constexpr (W == 0) {
+      out[j] = base;
+    } else {
+      const size_t bit = j * W;
+      uint64_t v = in[bit / 64] >> (bit % 64);
+      if (bit % 64 + W > 64)
+        v |= in[bit / 64 + 1] << (64 - bit % 64);
+      out[j] = base + (v & mask);
+    }
+  }
+}
+
+using unpack_fn = void (*)(const uint64_t *, uint64_t, uint64_t *);
+
+template <size_t... W> constexpr std::array<unpack_fn, sizeof...(W)> make_unpack_table(std::index_sequence<W...>) {
+  return {&unpack<W>...};
+}
+
+inline constexpr auto unpack_table = make_unpack_table(std::make_index_sequence<65>());
+} // namespace compressed_detail
+
+// Frame of reference + bit packing: each value is stored as value - min(block) in just enough bits for the largest
+// difference, so a block of values within 2^w of each other takes 2 * w words. Random access is O(1).
+struct for_encoding {
+  static block_header encode(const uint64_t *values, my_vector<uint64_t> &words) {
+    using compressed_detail::block_size;
+    const auto [lo, hi] = std::minmax_element(values, values + block_size);
+    const auto width = static_cast<unsigned>(std::bit_width(*hi - *lo));
+    const block_header header = compressed_detail::make_header(words.size(), width, *lo);
+    uint64_t *out = compressed_detail::append_words(words, block_size * width / 64);
+    for (size_t j = 0; j < block_size && width > 0; ++j) {
+      const size_t bit = j * width;
+      const uint64_t v = values[j] - *lo;
+      out[bit / 64] |= v << (bit % 64);
+      if (bit % 64 + width > 64)
+        out[bit / 64 + 1] |= v >> (64 - bit % 64);
+    }
+    return header;
+  }
+
+  // Dispatches to an unpacking loop specialised for the block's bit width. With the width and block size both
+  // constants every shift, mask and word index is known at compile time, so the loop compiles to straight-line code
+  // that the optimiser can unroll and vectorise; there is no per-value branch on the width.
+  static void decode(const uint64_t *words, const block_header &header, uint64_t *out) {
+    compressed_detail::unpack_table[header.width](words + header.offset, header.base, out);
+  }
+
+  static uint64_t get(const uint64_t *words, const block_header &header, size_t index) noexcept {
+    const unsigned width = header.width;
+    if (width == 0)
+      return header.base;
+    const uint64_t *in = words + header.offset;
+    const size_t bit = index * width;
+    uint64_t v = in[bit / 64] >> (bit % 64);
+    if (bit % 64 + width > 64)
+      v |= in[bit / 64 + 1] << (64 - bit % 64);
+    return header.base + (width == 64 ? v : v & ((uint64_t{1} << width) - 1));
+  }
+};
+
+// Delta + varint: the block keeps its first value in the header and stores the differences to the previous value as
+// LEB128 varints (7 bits per byte, high bit set on all but the last byte), so a non-decreasing sequence with small
+// gaps takes about one byte per value. Decreasing steps still round-trip but cost up to ten bytes. Random access
+// decodes from the start of the block.
+struct delta_varint_encoding {
+  static block_header encode(const uint64_t *values, my_vector<uint64_t> &words) {
+    using compressed_detail::block_size;
+    unsigned char bytes[block_size * 10];
+    size_t n = 0;
+    for (size_t j = 1; j < block_size; ++j) {
+      uint64_t delta = values[j] - values[j - 1];
+      for (; delta >= 0x80; delta >>= 7)
+        bytes[n++] = static_cast<unsigned char>(delta | 0x80);
+      bytes[n++] = static_cast<unsigned char>(delta);
+    }
+    const block_header header = compressed_detail::make_header(words.size(), 0, values[0]);
+    std::memcpy(compressed_detail::append_words(words, (n + 7) / 8), bytes, n);
+    return header;
+  }
+
+  static void decode(const uint64_t *words, const block_header &header, uint64_t *out) {
+    const auto *in = reinterpret_cast<const unsigned char *>(words + header.offset);
+    uint64_t value = header.base;
+    out[0] = value;
+    for (size_t j = 1; j < compressed_detail::block_size; ++j) {
+      value += read_varint(in);
+      out[j] = value;
+    }
+  }
+
+  static uint64_t get(const uint64_t *words, const block_header &header, size_t index) noexcept {
+    const auto *in = reinterpret_cast<const unsigned char *>(words + header.offset);
+    uint64_t value = header.base;
+    for (size_t j = 0; j < index; ++j)
+      value += read_varint(in);
+    return value;
+  }
+
+private:
+  static uint64_t read_varint(const unsigned char *&in) noexcept {
+    uint64_t result = *in & 0x7f;
+    for (unsigned shift = 7; *in++ & 0x80; shift += 7)
+      result |= uint64_t{*in & 0x7fu} << shift;
+    return result;
+  }
+};
+
+// Append-only, read-mostly vector of uint64_t stored compressed in a my_vector of words. Values are buffered until
+// a block is full and then encoded with Encoding; the last, partial block stays uncompressed. Element access finds
+// the block through its header, and scans decode one block at a time into a small buffer.
+template <typename Encoding = for_encoding> class compressed_int_vector {
+public:
+  static constexpr size_t block_size = compressed_detail::block_size;
+
+  compressed_int_vector() = default;
+
+  template <std::input_iterator II> compressed_int_vector(II first, II last) {
+    for (; first != last; ++first)
+      push_back(*first);
+  }
+
+  compressed_int_vector(std::initializer_list<uint64_t> init) : compressed_int_vector(init.begin(), init.end()) {}
+
+  size_t size() const noexcept { return _blocks.size() * block_size + _tail_size; }
+
+  bool is_empty() const noexcept { return size() == 0; }
+
+  void push_back(uint64_t value) {
+    _tail[_tail_size++] = value;
+    if (_tail_size == block_size) {
+      _blocks.push_back(Encoding::encode(_tail.data(), _words));
+      _tail_size = 0;
+    }
+  }
+
+  uint64_t operator[](size_t index) const noexcept {
+    const size_t block = index / block_size;
+    if (block == _blocks.size())
+      return _tail[index % block_size];
+    return Encoding::get(_words.data(), _blocks[block], index % block_size);
+  }
+
+  uint64_t at(size_t index) const {
+    if (index >= size())
+      throw std::out_of_range("Index out of range");
+    return (*this)[index];
+  }
+
+  uint64_t back() const noexcept { return (*this)[size() - 1]; }
+
+  // Number of blocks including the partial one, if any.
+  size_t block_count() const noexcept { return _blocks.size() + (_tail_size > 0 ? 1 : 0); }
+
+  // Decodes block `block` into out, which must have room for block_size values; returns how many it wrote.
+  size_t decode_block(size_t block, uint64_t *out) const {
+    if (block == _blocks.size()) {
+      std::copy(_tail.begin(), _tail.begin() + _tail_size, out);
+      return _tail_size;
+    }
+    Encoding::decode(_words.data(), _blocks[block], out);
+    return block_size;
+  }
+
+  // Calls fn(value) for every value in order.
+  template <typename F> void for_each(F &&fn) const {
+    my_array<uint64_t, block_size> buffer;
+    for (size_t b = 0; b < block_count(); ++b) {
+      const size_t n = decode_block(b, buffer.data());
+      for (size_t j = 0; j < n; ++j)
+        fn(buffer[j]);
+    }
+  }
+
+  my_vector<uint64_t> to_vector() const {
+    my_vector<uint64_t> result(size());
+    for (size_t b = 0; b < block_count(); ++b)
+      decode_block(b, result.data() + b * block_size);
+    return result;
+  }
+
+  // Index of the first value >= value, or size() if there is none. Requires the values to be non-decreasing: the
+  // block headers are binary searched first, so only one block is decoded.
+  size_t lower_bound(uint64_t value) const {
+    const auto *block = std::partition_point(_blocks.begin(), _blocks.end(),
+                                             [value](const block_header &h) { return h.base < value; });
+    if (_blocks.is_empty())
+      return static_cast<size_t>(std::lower_bound(_tail.begin(), _tail.begin() + _tail_size, value) - _tail.begin());
+    if (block == _blocks.begin())
+      return 0;
+    const auto b = static_cast<size_t>(block - _blocks.begin()) - 1;
+    my_array<uint64_t, block_size> buffer;
+    const size_t n = decode_block(b, buffer.data());
+    size_t j = static_cast<size_t>(std::lower_bound(buffer.begin(), buffer.begin() + n, value) - buffer.begin());
+    if (j == n && b + 1 == _blocks.size() && _tail_size > 0)
+      j += static_cast<size_t>(std::lower_bound(_tail.begin(), _tail.begin() + _tail_size, value) - _tail.begin());
+    return b * block_size + j;
+  }
+
+  // Bytes used by the encoded words, the block headers and the uncompressed tail.
+  size_t memory_usage() const noexcept {
+    return sizeof(*this) + _words.capacity() * sizeof(uint64_t) + _blocks.capacity() * sizeof(block_header);
+  }
+
+  // Uncompressed size (8 bytes per value) divided by memory_usage().
+  double compression_ratio() const noexcept {
+    return static_cast<double>(size() * sizeof(uint64_t)) / static_cast<double>(memory_usage());
+  }
+
+  void shrink_to_fit() {
+    _words.shrink_to_fit();
+    _blocks.shrink_to_fit();
+  }
+
+  const my_vector<uint64_t> &words() const noexcept { return _words; }
+
+private:
+  my_vector<uint64_t> _words;
+  my_vector<block_header> _blocks;
+  my_array<uint64_t, block_size> _tail;
+  size_t _tail_size = 0;
+};
+
+#endif // COMPRESSED_INT_VECTOR_HPP
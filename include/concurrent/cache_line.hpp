@@ -0,0 +1,12 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef CACHE_LINE_HPP
+#define CACHE_LINE_HPP
+
+#include <cstddef>
+
+// Fixed line size instead of std::hardware_destructive_interference_size, whose value GCC warns may differ
+// between translation units.
+inline constexpr std::size_t cache_line_size = 64;
+
+#endif // CACHE_LINE_HPP
@@ -0,0 +1,148 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MPMC_RING_HPP
+#define MPMC_RING_HPP
+
+#include <array/my_array.hpp>
+#include <concurrent/cache_line.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+// Bounded multi-producer/multi-consumer ring buffer with a sequence number per slot (D. Vyukov's design). A slot at
+// position p is free for the producer that claims p when its sequence equals p, and holds data for the consumer
+// that claims p when it equals p + 1; the consumer then hands it to the producer of p + N. try_push and try_pop are
+// lock-free and never wait on another thread.
+template <typename T, std::size_t N> class mpmc_ring {
+  static_assert(N >= 2 && std::has_single_bit(N), "mpmc_ring capacity must be a power of two");
+
+  struct slot {
+    std::atomic<std::size_t> sequence;
+    T value;
+  };
+
+public:
+  mpmc_ring() {
+    for (std::size_t i = 0; i < N; ++i)
+      _slots[i].sequence.store(i, std::memory_order_relaxed);
+  }
+
+  mpmc_ring(const mpmc_ring &) = delete;
+
+  mpmc_ring &operator=(const mpmc_ring &) = delete;
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+  template <typename U> bool try_push(U &&value) {
+    std::size_t pos = _enqueue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      slot &s = _slots[pos & mask];
+      const auto diff = distance(s.sequence.load(std::memory_order_acquire), pos);
+      if (diff == 0) {
+        if (_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          s.value = std::forward<U>(value);
+          s.sequence.store(pos + 1, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _enqueue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  bool try_pop(T &out) {
+    std::size_t pos = _dequeue_pos.load(std::memory_order_relaxed);
+    for (;;) {
+      slot &s = _slots[pos & mask];
+      const auto diff = distance(s.sequence.load(std::memory_order_acquire), pos + 1);
+      if (diff == 0) {
+        if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+          out = std::move(s.value);
+          s.sequence.store(pos + N, std::memory_order_release);
+          return true;
+        }
+      } else if (diff < 0) {
+        return false;
+      } else {
+        pos = _dequeue_pos.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Claims a run of up to count positions with one CAS. The run is only claimed once its last slot is free, so
+  // every earlier slot in it has already been claimed by a consumer; the loop below waits (briefly) only for such
+  // consumers that are still moving their element out. Returns how many items were pushed.
+  std::size_t push_n(const T *items, std::size_t count) {
+    const auto [first, n] = claim(_enqueue_pos, _dequeue_pos, N, count, 0);
+    for (std::size_t i = 0; i < n; ++i) {
+      slot &s = _slots[(first + i) & mask];
+      while (s.sequence.load(std::memory_order_acquire) != first + i)
+        std::this_thread::yield();
+      s.value = items[i];
+      s.sequence.store(first + i + 1, std::memory_order_release);
+    }
+    return n;
+  }
+
+  // Counterpart of push_n: claims a run whose last slot is already filled and waits only for producers of earlier
+  // positions that are still writing.
+  std::size_t pop_n(T *out, std::size_t max_count) {
+    const auto [first, n] = claim(_dequeue_pos, _enqueue_pos, 0, max_count, 1);
+    for (std::size_t i = 0; i < n; ++i) {
+      slot &s = _slots[(first + i) & mask];
+      while (s.sequence.load(std::memory_order_acquire) != first + i + 1)
+        std::this_thread::yield();
+      out[i] = std::move(s.value);
+      s.sequence.store(first + i + N, std::memory_order_release);
+    }
+    return n;
+  }
+
+  std::size_t size_approx() const noexcept {
+    const std::size_t tail = _enqueue_pos.load(std::memory_order_acquire);
+    const std::size_t head = _dequeue_pos.load(std::memory_order_acquire);
+    return tail > head ? tail - head : 0;
+  }
+
+private:
+  static constexpr std::size_t mask = N - 1;
+
+  static std::intptr_t distance(std::size_t sequence, std::size_t expected) noexcept {
+    return static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(expected);
+  }
+
+  // Claims [pos, pos + k) on the given counter. k starts from the number of positions the other counter says are
+  // ready (other + limit - pos) and is halved while the last slot of the run is not yet in the state the caller
+  // needs, sequence == position + offset. Returns {pos, k}; k is 0 when nothing is ready.
+  std::pair<std::size_t, std::size_t> claim(std::atomic<std::size_t> &counter, const std::atomic<std::size_t> &other,
+                                            std::size_t limit, std::size_t count, std::size_t offset) {
+    std::size_t pos = counter.load(std::memory_order_relaxed);
+    const std::size_t ready = other.load(std::memory_order_relaxed) + limit;
+    std::size_t k = std::min(count, ready > pos ? ready - pos : 0);
+    while (k > 0) {
+      const std::size_t last = pos + k - 1;
+      const auto diff = distance(_slots[last & mask].sequence.load(std::memory_order_acquire), last + offset);
+      if (diff == 0) {
+        if (counter.compare_exchange_weak(pos, pos + k, std::memory_order_relaxed))
+          return {pos, k};
+      } else if (diff < 0) {
+        k /= 2;
+      } else {
+        pos = counter.load(std::memory_order_relaxed);
+      }
+    }
+    return {pos, 0};
+  }
+
+  alignas(cache_line_size) std::atomic<std::size_t> _enqueue_pos{0};
+  alignas(cache_line_size) std::atomic<std::size_t> _dequeue_pos{0};
+  alignas(cache_line_size) my_array<slot, N> _slots;
+};
+
+#endif // MPMC_RING_HPP
@@ -0,0 +1,96 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef SPSC_RING_HPP
+#define SPSC_RING_HPP
+
+#include <array/my_array.hpp>
+#include <concurrent/cache_line.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <utility>
+
+// Wait-free single-producer/single-consumer ring buffer. Indices grow without wrapping and are masked on access.
+// Each side keeps a cached copy of the other side's index on its own cache line and only reloads the shared atomic
+// when the cached value says the ring looks full (producer) or empty (consumer).
+template <typename T, std::size_t N> class spsc_ring {
+  static_assert(N >= 2 && std::has_single_bit(N), "spsc_ring capacity must be a power of two");
+
+public:
+  spsc_ring() = default;
+
+  spsc_ring(const spsc_ring &) = delete;
+
+  spsc_ring &operator=(const spsc_ring &) = delete;
+
+  static constexpr std::size_t capacity() noexcept { return N; }
+
+  // Producer side.
+  template <typename U> bool try_push(U &&value) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail - _cached_head == N) {
+      _cached_head = _head.load(std::memory_order_acquire);
+      if (tail - _cached_head == N)
+        return false;
+    }
+    _slots[tail & mask] = std::forward<U>(value);
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Producer side. Copies up to count items and publishes them with a single store; returns how many fit.
+  std::size_t push_n(const T *items, std::size_t count) {
+    const std::size_t tail = _tail.load(std::memory_order_relaxed);
+    if (N - (tail - _cached_head) < count)
+      _cached_head = _head.load(std::memory_order_acquire);
+    const std::size_t n = std::min(count, N - (tail - _cached_head));
+    for (std::size_t i = 0; i < n; ++i)
+      _slots[(tail + i) & mask] = items[i];
+    _tail.store(tail + n, std::memory_order_release);
+    return n;
+  }
+
+  // Consumer side.
+  bool try_pop(T &out) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (head == _cached_tail) {
+      _cached_tail = _tail.load(std::memory_order_acquire);
+      if (head == _cached_tail)
+        return false;
+    }
+    out = std::move(_slots[head & mask]);
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Consumer side. Moves up to max_count items out and releases their slots with a single store.
+  std::size_t pop_n(T *out, std::size_t max_count) {
+    const std::size_t head = _head.load(std::memory_order_relaxed);
+    if (_cached_tail - head < max_count)
+      _cached_tail = _tail.load(std::memory_order_acquire);
+    const std::size_t n = std::min(max_count, _cached_tail - head);
+    for (std::size_t i = 0; i < n; ++i)
+      out[i] = std::move(_slots[(head + i) & mask]);
+    _head.store(head + n, std::memory_order_release);
+    return n;
+  }
+
+  // Exact only when called from one of the two sides while the other is idle.
+  std::size_t size_approx() const noexcept {
+    return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+  }
+
+private:
+  static constexpr std::size_t mask = N - 1;
+
+  // Consumer-owned line.
+  alignas(cache_line_size) std::atomic<std::size_t> _head{0};
+  std::size_t _cached_tail = 0;
+  // Producer-owned line.
+  alignas(cache_line_size) std::atomic<std::size_t> _tail{0};
+  std::size_t _cached_head = 0;
+  alignas(cache_line_size) my_array<T, N> _slots;
+};
+
+#endif // SPSC_RING_HPP
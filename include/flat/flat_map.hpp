@@ -0,0 +1,215 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef FLAT_MAP_HPP
+#define FLAT_MAP_HPP
+
+#include <flat/search_layout.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Sorted associative container with separate key and value columns: lookups only touch the densely packed keys.
+// As with flat_set, single inserts and erases cost O(n) each and insert_range is the way to add many entries; see
+// flat/search_layout.hpp for what mutations cost each layout.
+template <typename Key, typename T, typename Compare = std::less<Key>, typename Layout = sorted_layout>
+class flat_map {
+  template <bool Const> class basic_iterator {
+    using map_type = std::conditional_t<Const, const flat_map, flat_map>;
+    using mapped_ref = std::conditional_t<Const, const T &, T &>;
+
+  public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+    using value_type = std::pair<Key, T>;
+    using reference = std::pair<const Key &, mapped_ref>;
+
+    basic_iterator() = default;
+
+    basic_iterator(map_type *map, size_t idx) : _map(map), _idx(idx) {}
+
+    reference operator*() const { return {_map->_keys[_idx], _map->_values[_idx]}; }
+
+    basic_iterator &operator++() {
+      ++_idx;
+      return *this;
+    }
+
+    basic_iterator operator++(int) {
+      basic_iterator tmp = *this;
+      ++_idx;
+      return tmp;
+    }
+
+    bool operator==(const basic_iterator &other) const { return _idx == other._idx; }
+
+    bool operator!=(const basic_iterator &other) const { return _idx != other._idx; }
+
+    size_t index() const noexcept { return _idx; }
+
+  private:
+    map_type *_map = nullptr;
+    size_t _idx = 0;
+  };
+
+public:
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  flat_map() = default;
+
+  explicit flat_map(const Compare &comp) : _comp(comp) {}
+
+  template <std::forward_iterator II> flat_map(II first, II last, const Compare &comp = Compare()) : _comp(comp) {
+    insert_range(first, last);
+  }
+
+  flat_map(std::initializer_list<std::pair<Key, T>> init, const Compare &comp = Compare()) : _comp(comp) {
+    insert_range(init.begin(), init.end());
+  }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size()); }
+
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  size_t size() const { return _keys.size(); }
+
+  bool is_empty() const noexcept { return _keys.is_empty(); }
+
+  const my_vector<Key> &keys() const noexcept { return _keys; }
+
+  const my_vector<T> &values() const noexcept { return _values; }
+
+  void reserve(size_t n) {
+    _keys.reserve(n);
+    _values.reserve(n);
+  }
+
+  void clear() {
+    _keys.clear();
+    _values.clear();
+    _index.rebuild(_keys);
+  }
+
+  T *find(const Key &key) {
+    const size_t idx = index_of(key);
+    return idx != size() ? &_values[idx] : nullptr;
+  }
+
+  const T *find(const Key &key) const {
+    const size_t idx = index_of(key);
+    return idx != size() ? &_values[idx] : nullptr;
+  }
+
+  bool contains(const Key &key) const { return _index.contains(_keys, key, _comp); }
+
+  T &at(const Key &key) {
+    T *value = find(key);
+    if (!value)
+      throw std::out_of_range("flat_map::at");
+    return *value;
+  }
+
+  const T &at(const Key &key) const {
+    const T *value = find(key);
+    if (!value)
+      throw std::out_of_range("flat_map::at");
+    return *value;
+  }
+
+  T &operator[](const Key &key) { return _values[try_emplace(key).first.index()]; }
+
+  // The value is built before either column changes, and the key insert is undone if the value insert throws, so
+  // the columns stay in step.
+  template <typename... Args> std::pair<iterator, bool> try_emplace(const Key &key, Args &&...args) {
+    const size_t idx = _index.lower_bound(_keys, key, _comp);
+    if (idx != size() && !_comp(key, _keys[idx]))
+      return {iterator(this, idx), false};
+    const T value(std::forward<Args>(args)...);
+    _keys.insert(_keys.begin() + idx, key);
+    try {
+      _values.insert(_values.begin() + idx, value);
+    } catch (...) {
+      _keys.erase(_keys.begin() + idx);
+      throw;
+    }
+    _index.update(_keys);
+    return {iterator(this, idx), true};
+  }
+
+  std::pair<iterator, bool> insert(const Key &key, const T &value) { return try_emplace(key, value); }
+
+  std::pair<iterator, bool> insert_or_assign(const Key &key, const T &value) {
+    auto result = try_emplace(key, value);
+    if (!result.second)
+      _values[result.first.index()] = value;
+    return result;
+  }
+
+  // Bulk insertion of (key, value) pairs: only the new entries are sorted (through an index permutation, so both
+  // columns move once), then merged with the existing ones. Existing keys win, and among new duplicates the first.
+  template <std::forward_iterator II> void insert_range(II first, II last) {
+    const size_t old_size = size();
+    const size_t added = std::distance(first, last);
+    reserve(old_size + added);
+    for (; first != last; ++first) {
+      const auto &entry = *first;
+      _keys.emplace_back(entry.first);
+      _values.emplace_back(entry.second);
+    }
+    my_vector<size_t> order;
+    order.reserve(old_size + added);
+    for (size_t i = 0; i < old_size + added; ++i)
+      order.push_back(i);
+    auto by_key = [this](size_t a, size_t b) { return _comp(_keys[a], _keys[b]); };
+    std::stable_sort(order.begin() + old_size, order.end(), by_key);
+    std::inplace_merge(order.begin(), order.begin() + old_size, order.end(), by_key);
+    size_t *unique_end = std::unique(order.begin(), order.end(), [this](size_t a, size_t b) {
+      return !_comp(_keys[a], _keys[b]);
+    });
+
+    my_vector<Key> keys;
+    my_vector<T> values;
+    keys.reserve(unique_end - order.begin());
+    values.reserve(unique_end - order.begin());
+    for (const size_t *it = order.begin(); it != unique_end; ++it) {
+      keys.push_back(std::move(_keys[*it]));
+      values.push_back(std::move(_values[*it]));
+    }
+    _keys.swap(keys);
+    _values.swap(values);
+    _index.rebuild(_keys);
+  }
+
+  size_t erase(const Key &key) {
+    const size_t idx = index_of(key);
+    if (idx == size())
+      return 0;
+    // Values first: if shifting them throws, the key column is still untouched.
+    _values.erase(_values.begin() + idx);
+    _keys.erase(_keys.begin() + idx);
+    _index.update(_keys);
+    return 1;
+  }
+
+private:
+  size_t index_of(const Key &key) const { return _index.find(_keys, key, _comp); }
+
+  // Undoing a key insert and erasing keys after their values must not fail halfway.
+  static_assert(std::is_nothrow_move_assignable_v<Key>, "flat_map keys must be nothrow move assignable");
+
+  my_vector<Key> _keys;
+  my_vector<T> _values;
+  [[no_unique_address]] Compare _comp;
+  typename Layout::template index<Key, Compare> _index;
+};
+
+#endif // FLAT_MAP_HPP
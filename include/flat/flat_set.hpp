@@ -0,0 +1,99 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef FLAT_SET_HPP
+#define FLAT_SET_HPP
+
+#include <flat/search_layout.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <utility>
+
+// Sorted set on one my_vector of keys. Single inserts and erases shift the tail, so they cost O(n) each; insert_range
+// is the way to add many keys. See flat/search_layout.hpp for what mutations cost each layout.
+template <typename Key, typename Compare = std::less<Key>, typename Layout = sorted_layout> class flat_set {
+public:
+  flat_set() = default;
+
+  explicit flat_set(const Compare &comp) : _comp(comp) {}
+
+  template <std::forward_iterator II> flat_set(II first, II last, const Compare &comp = Compare()) : _comp(comp) {
+    insert_range(first, last);
+  }
+
+  flat_set(std::initializer_list<Key> init, const Compare &comp = Compare()) : _comp(comp) {
+    insert_range(init.begin(), init.end());
+  }
+
+  const Key *begin() const noexcept { return _keys.begin(); }
+
+  const Key *end() const noexcept { return _keys.end(); }
+
+  size_t size() const { return _keys.size(); }
+
+  bool is_empty() const noexcept { return _keys.is_empty(); }
+
+  const my_vector<Key> &keys() const noexcept { return _keys; }
+
+  void reserve(size_t n) { _keys.reserve(n); }
+
+  void clear() {
+    _keys.clear();
+    _index.rebuild(_keys);
+  }
+
+  const Key *lower_bound(const Key &key) const { return _keys.begin() + _index.lower_bound(_keys, key, _comp); }
+
+  const Key *find(const Key &key) const { return _keys.begin() + _index.find(_keys, key, _comp); }
+
+  bool contains(const Key &key) const { return _index.contains(_keys, key, _comp); }
+
+  size_t count(const Key &key) const { return contains(key) ? 1 : 0; }
+
+  std::pair<const Key *, bool> insert(const Key &key) {
+    const size_t idx = _index.lower_bound(_keys, key, _comp);
+    if (idx != _keys.size() && !_comp(key, _keys[idx]))
+      return {_keys.begin() + idx, false};
+    _keys.insert(_keys.begin() + idx, key);
+    _index.update(_keys);
+    return {_keys.begin() + idx, true};
+  }
+
+  // Bulk insertion: appends the whole range, sorts only the new tail and merges it in, then drops duplicates in
+  // one pass. Existing elements win over equivalent new ones, and earlier new elements over later ones.
+  template <std::forward_iterator II> void insert_range(II first, II last) {
+    const size_t old_size = _keys.size();
+    _keys.reserve(old_size + std::distance(first, last));
+    for (; first != last; ++first)
+      _keys.emplace_back(*first);
+    Key *mid = _keys.begin() + old_size;
+    std::stable_sort(mid, _keys.end(), _comp);
+    std::inplace_merge(_keys.begin(), mid, _keys.end(), _comp);
+    Key *new_end =
+        std::unique(_keys.begin(), _keys.end(), [this](const Key &a, const Key &b) { return !_comp(a, b); });
+    _keys.erase(new_end, _keys.end());
+    _index.rebuild(_keys);
+  }
+
+  size_t erase(const Key &key) {
+    const Key *it = find(key);
+    if (it == end())
+      return 0;
+    _keys.erase(it);
+    _index.update(_keys);
+    return 1;
+  }
+
+  bool operator==(const flat_set &other) const { return _keys == other._keys; }
+
+  bool operator!=(const flat_set &other) const { return !(*this == other); }
+
+private:
+  my_vector<Key> _keys;
+  [[no_unique_address]] Compare _comp;
+  typename Layout::template index<Key, Compare> _index;
+};
+
+#endif // FLAT_SET_HPP
@@ -0,0 +1,144 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef SEARCH_LAYOUT_HPP
+#define SEARCH_LAYOUT_HPP
+
+#include <vector/my_vector.hpp>
+#include <bit>
+#include <cstddef>
+
+// Search layouts used by flat_set / flat_map. A layout answers lower_bound queries over the sorted key column. The
+// container calls rebuild() after bulk changes and update() after inserting or erasing a single key; a layout with
+// its own copy of the keys may defer the work of update() as long as its answers stay correct.
+
+inline void prefetch_for_read(const void *address) noexcept {
+#if defined(__GNUC__) || defined(__clang__)
+  __builtin_prefetch(address, 0, 3);
+#else
+  (void)address;
+#endif
+}
+
+// Plain binary search over the sorted column, written without data-dependent branches.
+struct sorted_layout {
+  template <typename Key, typename Compare> class index {
+  public:
+    void rebuild(const my_vector<Key> &) {}
+
+    void update(const my_vector<Key> &) {}
+
+    size_t lower_bound(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      const Key *base = keys.begin();
+      size_t n = keys.size();
+      if (n == 0)
+        return 0;
+      while (n > 1) {
+        const size_t half = n / 2;
+        base = comp(base[half - 1], key) ? base + half : base;
+        n -= half;
+      }
+      return (base - keys.begin()) + comp(*base, key);
+    }
+
+    size_t find(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      const size_t idx = lower_bound(keys, key, comp);
+      return idx != keys.size() && !comp(key, keys[idx]) ? idx : keys.size();
+    }
+
+    bool contains(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      return find(keys, key, comp) != keys.size();
+    }
+  };
+};
+
+// Eytzinger (BFS-order) copy of the keys: the hot top levels of the implicit tree share a few cache lines, and the
+// descendants four levels down are prefetched while the current comparison is in flight.
+//
+// Building the copy costs O(n), so single-key updates are batched: the copy is rebuilt once the updates since the
+// last build reach an eighth of the size, which keeps the rebuild cost per update amortized O(1). Until then the
+// copy is stale and lookups use the binary search of sorted_layout on the key column. Tables built up one key at a
+// time therefore get the Eytzinger speed-up only once they settle; build them with insert_range where possible.
+struct eytzinger_layout {
+  template <typename Key, typename Compare> class index {
+    using fallback = sorted_layout::index<Key, Compare>;
+
+  public:
+    void rebuild(const my_vector<Key> &keys) {
+      _pending = 0;
+      const size_t n = keys.size();
+      if (n == 0) {
+        _tree = my_vector<Key>();
+        _rank = my_vector<size_t>();
+        return;
+      }
+      my_vector<Key> tree(n + 1, keys[0]);
+      my_vector<size_t> rank(n + 1, n);
+      size_t next = 0;
+      fill(keys, tree, rank, next, 1);
+      _tree.swap(tree);
+      _rank.swap(rank);
+    }
+
+    void update(const my_vector<Key> &keys) {
+      if (++_pending > keys.size() / rebuild_fraction)
+        rebuild(keys);
+    }
+
+    bool is_stale() const noexcept { return _pending != 0; }
+
+    size_t lower_bound(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      if (is_stale())
+        return fallback().lower_bound(keys, key, comp);
+      const size_t k = descend(keys.size(), key, comp);
+      return k == 0 ? keys.size() : _rank[k];
+    }
+
+    // The equality check reuses the tree slot that was just visited instead of touching the sorted column.
+    size_t find(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      if (is_stale())
+        return fallback().find(keys, key, comp);
+      const size_t k = descend(keys.size(), key, comp);
+      return k != 0 && !comp(key, _tree[k]) ? _rank[k] : keys.size();
+    }
+
+    bool contains(const my_vector<Key> &keys, const Key &key, const Compare &comp) const {
+      if (is_stale())
+        return fallback().contains(keys, key, comp);
+      const size_t k = descend(keys.size(), key, comp);
+      return k != 0 && !comp(key, _tree[k]);
+    }
+
+  private:
+    // Returns the tree slot of the first element not less than key, or 0 when there is none.
+    size_t descend(size_t n, const Key &key, const Compare &comp) const {
+      const Key *tree = _tree.begin();
+      size_t k = 1;
+      while (k <= n) {
+        prefetch_for_read(tree + std::min(k * prefetch_stride, n));
+        k = 2 * k + comp(tree[k], key);
+      }
+      return k >> (std::countr_one(k) + 1);
+    }
+
+    // Slot k * 16 is the first of the 16 great-great-grandchildren of k, stored next to each other.
+    static constexpr size_t prefetch_stride = 16;
+    static constexpr size_t rebuild_fraction = 8;
+
+    static void fill(const my_vector<Key> &keys, my_vector<Key> &tree, my_vector<size_t> &rank, size_t &next,
+                     size_t k) {
+      if (k >= tree.size())
+        return;
+      fill(keys, tree, rank, next, 2 * k);
+      tree[k] = keys[next];
+      rank[k] = next++;
+      fill(keys, tree, rank, next, 2 * k + 1);
+    }
+
+    my_vector<Key> _tree;
+    my_vector<size_t> _rank;
+    // Single-key updates since the last rebuild.
+    size_t _pending = 0;
+  };
+};
+
+#endif // SEARCH_LAYOUT_HPP
@@ -0,0 +1,356 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef GAP_BUFFER_HPP
+#define GAP_BUFFER_HPP
+
+#include <span/my_span.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <compare>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+// Sequence for insert/erase-heavy editing near a moving cursor. The elements live in one my_vector with a gap of
+// spare slots at the last edit point: [0, gap_begin) holds the elements before the gap, [gap_end, capacity) the
+// ones after it. An insert or erase first moves the gap to its position, which shifts only the elements between the
+// old and the new edit point, and then fills or widens the gap in O(1); edits that stay close to each other cost
+// O(1) amortized instead of a move of the whole tail. When the gap runs out the storage doubles, keeping the
+// elements before and after the gap at its two ends.
+//
+// The gap slots are live, default-constructed (or moved-from) objects, so T must be default constructible and move
+// assignable. Indexing and the iterators go through the gap with a branch; bulk reads should use for_each_segment()
+// or before_gap()/after_gap(), and code that needs one pointer range calls contiguous(), which moves the gap to the
+// end. Iterators are invalidated by every insert, erase and contiguous().
+template <typename T> class gap_buffer {
+  static_assert(std::is_default_constructible_v<T> && std::is_move_assignable_v<T>,
+                "gap_buffer needs default constructible, move assignable elements");
+
+  template <bool Const> class basic_iterator {
+    using owner = std::conditional_t<Const, const gap_buffer, gap_buffer>;
+
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = std::conditional_t<Const, const T *, T *>;
+    using reference = std::conditional_t<Const, const T &, T &>;
+
+    basic_iterator() noexcept = default;
+
+    basic_iterator(owner *buffer, size_t index) noexcept : _buffer(buffer), _index(index) {}
+
+    template <bool C = Const, typename = std::enable_if_t<C>>
+    basic_iterator(const basic_iterator<false> &other) noexcept : _buffer(other._buffer), _index(other._index) {}
+
+    reference operator*() const noexcept { return (*_buffer)[_index]; }
+
+    pointer operator->() const noexcept { return &(*_buffer)[_index]; }
+
+    reference operator[](difference_type n) const noexcept { return (*_buffer)[_index + n]; }
+
+    size_t index() const noexcept { return _index; }
+
+    basic_iterator &operator++() noexcept {
+      ++_index;
+      return *this;
+    }
+
+    basic_iterator operator++(int) noexcept {
+      basic_iterator copy = *this;
+      ++_index;
+      return copy;
+    }
+
+    basic_iterator &operator--() noexcept {
+      --_index;
+      return *this;
+    }
+
+    basic_iterator operator--(int) noexcept {
+      basic_iterator copy = *this;
+      --_index;
+      return copy;
+    }
+
+    basic_iterator &operator+=(difference_type n) noexcept {
+      _index += n;
+      return *this;
+    }
+
+    basic_iterator &operator-=(difference_type n) noexcept {
+      _index -= n;
+      return *this;
+    }
+
+    friend basic_iterator operator+(basic_iterator it, difference_type n) noexcept { return it += n; }
+
+    friend basic_iterator operator+(difference_type n, basic_iterator it) noexcept { return it += n; }
+
+    friend basic_iterator operator-(basic_iterator it, difference_type n) noexcept { return it -= n; }
+
+    friend difference_type operator-(const basic_iterator &a, const basic_iterator &b) noexcept {
+      return static_cast<difference_type>(a._index) - static_cast<difference_type>(b._index);
+    }
+
+    friend bool operator==(const basic_iterator &a, const basic_iterator &b) noexcept { return a._index == b._index; }
+
+    friend std::strong_ordering operator<=>(const basic_iterator &a, const basic_iterator &b) noexcept {
+      return a._index <=> b._index;
+    }
+
+  private:
+    friend class gap_buffer;
+    friend class basic_iterator<!Const>;
+
+    owner *_buffer = nullptr;
+    size_t _index = 0;
+  };
+
+public:
+  using value_type = T;
+  using iterator = basic_iterator<false>;
+  using const_iterator = basic_iterator<true>;
+
+  gap_buffer() = default;
+
+  gap_buffer(size_t n, const T &value) : _data(n, value), _gap_begin(n), _gap_end(n) {}
+
+  template <std::forward_iterator II> gap_buffer(II first, II last) : _data(first, last) {
+    _gap_begin = _gap_end = _data.size();
+  }
+
+  gap_buffer(std::initializer_list<T> init) : gap_buffer(init.begin(), init.end()) {}
+
+  T &operator[](size_t index) noexcept { return _data[physical(index)]; }
+
+  const T &operator[](size_t index) const noexcept { return _data[physical(index)]; }
+
+  T &at(size_t index) {
+    if (index >= size())
+      throw std::out_of_range("Index out of range");
+    return (*this)[index];
+  }
+
+  const T &at(size_t index) const {
+    if (index >= size())
+      throw std::out_of_range("Index out of range");
+    return (*this)[index];
+  }
+
+  T &front() { return (*this)[0]; }
+
+  const T &front() const { return (*this)[0]; }
+
+  T &back() { return (*this)[size() - 1]; }
+
+  const T &back() const { return (*this)[size() - 1]; }
+
+  iterator begin() noexcept { return iterator(this, 0); }
+
+  const_iterator begin() const noexcept { return const_iterator(this, 0); }
+
+  iterator end() noexcept { return iterator(this, size()); }
+
+  const_iterator end() const noexcept { return const_iterator(this, size()); }
+
+  const_iterator cbegin() const noexcept { return begin(); }
+
+  const_iterator cend() const noexcept { return end(); }
+
+  size_t size() const noexcept { return _data.size() - gap_size(); }
+
+  size_t capacity() const noexcept { return _data.size(); }
+
+  bool is_empty() const noexcept { return size() == 0; }
+
+  // Logical index of the gap, i.e. the number of elements in front of it.
+  size_t gap_position() const noexcept { return _gap_begin; }
+
+  size_t gap_size() const noexcept { return _gap_end - _gap_begin; }
+
+  size_t memory_usage() const noexcept { return _data.memory_usage(); }
+
+  // The elements in front of and behind the gap; together they are the whole sequence, in order.
+  my_span<const T> before_gap() const noexcept { return my_span<const T>(_data.data(), _gap_begin); }
+
+  my_span<const T> after_gap() const noexcept {
+    return my_span<const T>(_data.data() + _gap_end, _data.size() - _gap_end);
+  }
+
+  // Calls fn(const T *first, const T *last) once per non-empty segment, in order.
+  template <typename F> void for_each_segment(F &&fn) const {
+    if (_gap_begin != 0)
+      fn(_data.data(), _data.data() + _gap_begin);
+    if (_gap_end != _data.size())
+      fn(_data.data() + _gap_end, _data.data() + _data.size());
+  }
+
+  // Moves the gap to the end and returns the elements as one range. Costs a move of everything behind the gap the
+  // first time and nothing while no edit happens in between.
+  my_span<T> contiguous() {
+    move_gap(size());
+    return my_span<T>(_data.data(), size());
+  }
+
+  T *data() { return contiguous().data(); }
+
+  my_vector<T> to_vector() const {
+    my_vector<T> result;
+    result.reserve(size());
+    for_each_segment([&](const T *first, const T *last) { result.insert(result.end(), first, last); });
+    return result;
+  }
+
+  // Places the gap in front of the element at index, shifting only the elements between the old and the new gap
+  // position. Inserts and erases do this themselves; calling it ahead of a burst of edits is optional.
+  void move_gap(size_t index) {
+    if (index > size())
+      throw std::out_of_range("Index out of range");
+    if (_gap_begin == _gap_end) {
+      // Nothing to shift, and shifting would move every element onto itself.
+      _gap_begin = _gap_end = index;
+    } else if (index < _gap_begin) {
+      const size_t count = _gap_begin - index;
+      std::move_backward(_data.begin() + index, _data.begin() + _gap_begin, _data.begin() + _gap_end);
+      _gap_begin -= count;
+      _gap_end -= count;
+    } else if (index > _gap_begin) {
+      const size_t count = index - _gap_begin;
+      std::move(_data.begin() + _gap_end, _data.begin() + _gap_end + count, _data.begin() + _gap_begin);
+      _gap_begin += count;
+      _gap_end += count;
+    }
+  }
+
+  void reserve(size_t n) {
+    if (n > capacity())
+      regrow(n);
+  }
+
+  void shrink_to_fit() {
+    if (gap_size() != 0)
+      regrow(size());
+  }
+
+  iterator insert(const_iterator pos, const T &value) { return emplace(pos, value); }
+
+  iterator insert(const_iterator pos, T &&value) { return emplace(pos, std::move(value)); }
+
+  template <typename... Args> iterator emplace(const_iterator pos, Args &&...args) {
+    // Built before the gap moves, since args may refer to elements of this buffer.
+    T value(std::forward<Args>(args)...);
+    const size_t idx = pos._index;
+    move_gap(idx);
+    if (_gap_begin == _gap_end)
+      regrow(std::max(capacity() * 2, min_capacity));
+    _data[_gap_begin] = std::move(value);
+    ++_gap_begin;
+    return iterator(this, idx);
+  }
+
+  template <std::forward_iterator II,
+            typename = std::enable_if_t<std::is_assignable_v<T &, typename std::iterator_traits<II>::reference>>>
+  iterator insert(const_iterator pos, II first, II last) {
+    const auto count = static_cast<size_t>(std::distance(first, last));
+    if (count != 0 && refers_to_this(first)) {
+      // Moving the gap or regrowing would shift or free the source under the copy.
+      my_vector<T> copy(count);
+      std::copy(first, last, copy.begin());
+      return insert(pos, copy.begin(), copy.end());
+    }
+    const size_t idx = pos._index;
+    move_gap(idx);
+    if (gap_size() < count)
+      regrow(std::max({capacity() * 2, size() + count, min_capacity}));
+    std::copy(first, last, _data.begin() + _gap_begin);
+    _gap_begin += count;
+    return iterator(this, idx);
+  }
+
+  iterator insert(const_iterator pos, std::initializer_list<T> values) {
+    return insert(pos, values.begin(), values.end());
+  }
+
+  iterator erase(const_iterator pos) { return erase(pos, pos + 1); }
+
+  iterator erase(const_iterator first, const_iterator last) {
+    const size_t idx = first._index;
+    move_gap(idx);
+    const size_t count = last._index - idx;
+    release_slots(_gap_end, _gap_end + count);
+    _gap_end += count;
+    return iterator(this, idx);
+  }
+
+  void push_back(const T &value) { insert(end(), value); }
+
+  void push_back(T &&value) { insert(end(), std::move(value)); }
+
+  template <typename... Args> void emplace_back(Args &&...args) { emplace(end(), std::forward<Args>(args)...); }
+
+  void pop_back() { erase(end() - 1); }
+
+  void clear() {
+    release_slots(0, _gap_begin);
+    release_slots(_gap_end, _data.size());
+    _gap_begin = 0;
+    _gap_end = _data.size();
+  }
+
+  void swap(gap_buffer &other) noexcept {
+    _data.swap(other._data);
+    std::swap(_gap_begin, other._gap_begin);
+    std::swap(_gap_end, other._gap_end);
+  }
+
+  bool operator==(const gap_buffer &other) const {
+    return size() == other.size() && std::equal(begin(), end(), other.begin());
+  }
+
+  bool operator!=(const gap_buffer &other) const { return !(*this == other); }
+
+private:
+  static constexpr size_t min_capacity = 16;
+
+  size_t physical(size_t index) const noexcept { return index < _gap_begin ? index : index + gap_size(); }
+
+  // Whether it walks this buffer: its own iterators, or pointers into its storage.
+  template <typename II> bool refers_to_this(const II &it) const noexcept {
+    if constexpr (std::is_same_v<II, iterator> || std::is_same_v<II, const_iterator>) {
+      return it._buffer == this;
+    } else if constexpr (std::is_pointer_v<II> && std::is_same_v<std::remove_cv_t<std::remove_pointer_t<II>>, T>) {
+      const T *p = it;
+      return !std::less<const T *>()(p, _data.data()) && std::less<const T *>()(p, _data.data() + _data.size());
+    } else {
+      return false;
+    }
+  }
+
+  // Erased slots join the gap; resetting them frees whatever the elements owned instead of keeping it until the
+  // slot is reused.
+  void release_slots(size_t first, size_t last) {
+    if constexpr (!std::is_trivially_destructible_v<T>)
+      std::fill(_data.begin() + first, _data.begin() + last, T());
+  }
+
+  // Moves the elements into storage of new_cap slots, keeping the gap where it is.
+  void regrow(size_t new_cap) {
+    const size_t after = _data.size() - _gap_end;
+    my_vector<T> grown(new_cap);
+    std::move(_data.begin(), _data.begin() + _gap_begin, grown.begin());
+    std::move(_data.begin() + _gap_end, _data.end(), grown.end() - after);
+    _data.swap(grown);
+    _gap_end = new_cap - after;
+  }
+
+  my_vector<T> _data;
+  size_t _gap_begin = 0;
+  size_t _gap_end = 0;
+};
+
+#endif // GAP_BUFFER_HPP
@@ -0,0 +1,174 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MY_HASH_HPP
+#define MY_HASH_HPP
+
+#include <array/my_array.hpp>
+#include <span/my_span.hpp>
+#include <vector/my_vector.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+// Hashing of contiguous containers. Elements whose object representation is their value (integers, enums,
+// pointers, padding-free structs of those; see std::has_unique_object_representations) are hashed as one byte range
+// with a wyhash-style function: 16 bytes per step through a 64x64->128-bit multiply, with three independent lanes
+// for inputs over 48 bytes so that the multiplies overlap. Other element types, including floating point (where
+// 0.0 == -0.0), are hashed one by one with std::hash and combined.
+
+template <typename T> inline constexpr bool is_trivially_hashable_v = std::has_unique_object_representations_v<T>;
+
+namespace my_hash_detail {
+inline constexpr uint64_t secret[4] = {0x2d358dccaa6c78a5ULL, 0x8bb84b93962eacc9ULL, 0x4b33a62ed433d4a3ULL,
+                                       0x4d5a2da51de1aa47ULL};
+
+// Full 128-bit product of a and b; a receives the low half and b the high half.
+inline void multiply(uint64_t &a, uint64_t &b) noexcept {
+#if defined(__SIZEOF_INT128__)
+  // __extension__ keeps -pedantic quiet about the non-ISO type.
+  __extension__ using uint128 = unsigned __int128;
+  const uint128 r = static_cast<uint128>(a) * b;
+  a = static_cast<uint64_t>(r);
+  b = static_cast<uint64_t>(r >> 64);
+#else
+  const uint64_t ha = a >> 32, hb = b >> 32, la = static_cast<uint32_t>(a), lb = static_cast<uint32_t>(b);
+  const uint64_t rh = ha * hb, rm0 = ha * lb, rm1 = hb * la, rl = la * lb;
+  const uint64_t t = rl + (rm0 << 32);
+  const uint64_t lo = t + (rm1 << 32);
+  const uint64_t carry = (t < rl) + (lo < t);
+  b = rh + (rm0 >> 32) + (rm1 >> 32) + carry;
+  a = lo;
+#endif
+}
+
+inline uint64_t mix(uint64_t a, uint64_t b) noexcept {
+  multiply(a, b);
+  return a ^ b;
+}
+
+inline uint64_t read8(const unsigned char *p) noexcept {
+  uint64_t v;
+  std::memcpy(&v, p, 8);
+  return v;
+}
+
+inline uint64_t read4(const unsigned char *p) noexcept {
+  uint32_t v;
+  std::memcpy(&v, p, 4);
+  return v;
+}
+
+// One to three bytes.
+inline uint64_t read_small(const unsigned char *p, size_t n) noexcept {
+  return (uint64_t{p[0]} << 16) | (uint64_t{p[n >> 1]} << 8) | p[n - 1];
+}
+} // namespace my_hash_detail
+
+inline uint64_t hash_bytes(const void *data, size_t len, uint64_t seed = 0) noexcept {
+  using namespace my_hash_detail;
+  const auto *p = static_cast<const unsigned char *>(data);
+  seed ^= mix(seed ^ secret[0], secret[1]);
+  uint64_t a = 0;
+  uint64_t b = 0;
+  if (len <= 16) {
+    if (len >= 4) {
+      const size_t shift = (len >> 3) << 2;
+      a = (read4(p) << 32) | read4(p + shift);
+      b = (read4(p + len - 4) << 32) | read4(p + len - 4 - shift);
+    } else if (len > 0) {
+      a = read_small(p, len);
+    }
+  } else {
+    size_t i = len;
+    if (i > 48) {
+      uint64_t lane1 = seed;
+      uint64_t lane2 = seed;
+      do {
+        seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+        lane1 = mix(read8(p + 16) ^ secret[2], read8(p + 24) ^ lane1);
+        lane2 = mix(read8(p + 32) ^ secret[3], read8(p + 40) ^ lane2);
+        p += 48;
+        i -= 48;
+      } while (i > 48);
+      seed ^= lane1 ^ lane2;
+    }
+    while (i > 16) {
+      seed = mix(read8(p) ^ secret[1], read8(p + 8) ^ seed);
+      i -= 16;
+      p += 16;
+    }
+    a = read8(p + i - 16);
+    b = read8(p + i - 8);
+  }
+  a ^= secret[1];
+  b ^= seed;
+  multiply(a, b);
+  return mix(a ^ secret[0] ^ len, b ^ secret[1]);
+}
+
+// Folds h into seed; order-dependent.
+inline uint64_t hash_combine(uint64_t seed, uint64_t h) noexcept {
+  return my_hash_detail::mix(seed ^ my_hash_detail::secret[0], h ^ my_hash_detail::secret[1]);
+}
+
+template <typename T> uint64_t hash_range(const T *data, size_t n, uint64_t seed = 0) {
+  if constexpr (is_trivially_hashable_v<T>) {
+    return hash_bytes(data, n * sizeof(T), seed);
+  } else {
+    uint64_t h = hash_combine(seed, n);
+    for (size_t i = 0; i < n; ++i)
+      h = hash_combine(h, std::hash<T>()(data[i]));
+    return h;
+  }
+}
+
+template <typename T> uint64_t hash_value(my_span<T> values, uint64_t seed = 0) {
+  return hash_range<std::remove_const_t<T>>(values.data(), values.size(), seed);
+}
+
+template <typename T> uint64_t hash_value(const my_vector<T> &values, uint64_t seed = 0) {
+  return hash_range(values.data(), values.size(), seed);
+}
+
+template <typename T, size_t N> uint64_t hash_value(const my_array<T, N> &values, uint64_t seed = 0) {
+  return hash_range(values.data(), N, seed);
+}
+
+// Immutable key that carries its hash, computed once on construction. Lookups in hash containers then cost no
+// rehashing, and operator== rejects most non-equal keys by comparing the stored hashes first.
+template <typename Key, typename Hash = std::hash<Key>> class cached_hash {
+public:
+  explicit cached_hash(Key key) : _key(std::move(key)), _hash(Hash()(_key)) {}
+
+  template <typename... Args>
+  explicit cached_hash(std::in_place_t, Args &&...args) : _key(std::forward<Args>(args)...), _hash(Hash()(_key)) {}
+
+  const Key &get() const noexcept { return _key; }
+
+  size_t hash() const noexcept { return _hash; }
+
+  bool operator==(const cached_hash &other) const { return _hash == other._hash && _key == other._key; }
+
+  bool operator!=(const cached_hash &other) const { return !(*this == other); }
+
+private:
+  Key _key;
+  size_t _hash;
+};
+
+template <typename T> struct std::hash<my_vector<T>> {
+  size_t operator()(const my_vector<T> &values) const { return static_cast<size_t>(hash_value(values)); }
+};
+
+template <typename T, size_t N> struct std::hash<my_array<T, N>> {
+  size_t operator()(const my_array<T, N> &values) const { return static_cast<size_t>(hash_value(values)); }
+};
+
+template <typename Key, typename Hash> struct std::hash<cached_hash<Key, Hash>> {
+  size_t operator()(const cached_hash<Key, Hash> &key) const noexcept { return key.hash(); }
+};
+
+#endif // MY_HASH_HPP
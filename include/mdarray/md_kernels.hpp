@@ -0,0 +1,53 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MD_KERNELS_HPP
+#define MD_KERNELS_HPP
+
+#include <mdarray/md_view.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <stdexcept>
+
+// Matrix kernels over md_view, for any pair of layouts. They walk the matrix in Tile x Tile blocks so that, whatever
+// the source and destination layouts, both the lines read and the lines written by one block stay in cache until the
+// block is done. The default tile of 32 keeps two float or double tiles well inside L1.
+
+// dst(j, i) = src(i, j).
+template <std::size_t Tile = 32, typename T, typename U, typename SrcLayout, typename DstLayout>
+void md_transpose(const md_view<T, SrcLayout, 2> &src, const md_view<U, DstLayout, 2> &dst) {
+  const std::size_t rows = src.extent(0);
+  const std::size_t cols = src.extent(1);
+  if (dst.extent(0) != cols || dst.extent(1) != rows)
+    throw std::invalid_argument("md_transpose: extents do not match");
+  for (std::size_t ii = 0; ii < rows; ii += Tile) {
+    const std::size_t i_end = std::min(ii + Tile, rows);
+    for (std::size_t jj = 0; jj < cols; jj += Tile) {
+      const std::size_t j_end = std::min(jj + Tile, cols);
+      for (std::size_t i = ii; i < i_end; ++i) {
+        for (std::size_t j = jj; j < j_end; ++j)
+          dst(j, i) = src(i, j);
+      }
+    }
+  }
+}
+
+// dst(i, j) = src(i, j); converts between layouts.
+template <std::size_t Tile = 32, typename T, typename U, typename SrcLayout, typename DstLayout>
+void md_copy(const md_view<T, SrcLayout, 2> &src, const md_view<U, DstLayout, 2> &dst) {
+  const std::size_t rows = src.extent(0);
+  const std::size_t cols = src.extent(1);
+  if (dst.extent(0) != rows || dst.extent(1) != cols)
+    throw std::invalid_argument("md_copy: extents do not match");
+  for (std::size_t ii = 0; ii < rows; ii += Tile) {
+    const std::size_t i_end = std::min(ii + Tile, rows);
+    for (std::size_t jj = 0; jj < cols; jj += Tile) {
+      const std::size_t j_end = std::min(jj + Tile, cols);
+      for (std::size_t i = ii; i < i_end; ++i) {
+        for (std::size_t j = jj; j < j_end; ++j)
+          dst(i, j) = src(i, j);
+      }
+    }
+  }
+}
+
+#endif // MD_KERNELS_HPP
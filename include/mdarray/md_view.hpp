@@ -0,0 +1,185 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MD_VIEW_HPP
+#define MD_VIEW_HPP
+
+#include <array/my_array.hpp>
+#include <bit>
+#include <cstddef>
+#include <type_traits>
+
+#if __has_include(<mdspan>)
+#include <array>
+#include <mdspan>
+#endif
+
+// Layout policies map a multidimensional index to an offset into contiguous storage. The interface follows
+// std::mdspan's: Layout::mapping<Rank> has extents(), extent(r), operator()(indices...) and required_span_size(),
+// and each policy additionally reports static_span_size<Extents...>() so fixed-size storage can be sized at compile
+// time.
+
+// Row-major: the last index is contiguous.
+struct layout_right {
+  template <std::size_t Rank> class mapping {
+    static_assert(Rank > 0, "rank must be positive");
+
+  public:
+    explicit mapping(const my_array<std::size_t, Rank> &extents) : _extents(extents) {
+      std::size_t stride = 1;
+      for (std::size_t r = Rank; r-- > 0;) {
+        _strides[r] = stride;
+        stride *= extents[r];
+      }
+    }
+
+    const my_array<std::size_t, Rank> &extents() const noexcept { return _extents; }
+
+    std::size_t extent(std::size_t r) const noexcept { return _extents[r]; }
+
+    std::size_t stride(std::size_t r) const noexcept { return _strides[r]; }
+
+    std::size_t required_span_size() const noexcept { return _strides[0] * _extents[0]; }
+
+    template <typename... I> std::size_t operator()(I... indices) const noexcept {
+      static_assert(sizeof...(I) == Rank, "wrong number of indices");
+      const std::size_t idx[] = {static_cast<std::size_t>(indices)...};
+      std::size_t offset = 0;
+      for (std::size_t r = 0; r < Rank; ++r)
+        offset += idx[r] * _strides[r];
+      return offset;
+    }
+
+  private:
+    my_array<std::size_t, Rank> _extents;
+    my_array<std::size_t, Rank> _strides;
+  };
+
+  template <std::size_t... Extents> static constexpr std::size_t static_span_size() { return (Extents * ... * 1); }
+};
+
+// Column-major: the first index is contiguous.
+struct layout_left {
+  template <std::size_t Rank> class mapping {
+    static_assert(Rank > 0, "rank must be positive");
+
+  public:
+    explicit mapping(const my_array<std::size_t, Rank> &extents) : _extents(extents) {
+      std::size_t stride = 1;
+      for (std::size_t r = 0; r < Rank; ++r) {
+        _strides[r] = stride;
+        stride *= extents[r];
+      }
+    }
+
+    const my_array<std::size_t, Rank> &extents() const noexcept { return _extents; }
+
+    std::size_t extent(std::size_t r) const noexcept { return _extents[r]; }
+
+    std::size_t stride(std::size_t r) const noexcept { return _strides[r]; }
+
+    std::size_t required_span_size() const noexcept { return _strides[Rank - 1] * _extents[Rank - 1]; }
+
+    template <typename... I> std::size_t operator()(I... indices) const noexcept {
+      static_assert(sizeof...(I) == Rank, "wrong number of indices");
+      const std::size_t idx[] = {static_cast<std::size_t>(indices)...};
+      std::size_t offset = 0;
+      for (std::size_t r = 0; r < Rank; ++r)
+        offset += idx[r] * _strides[r];
+      return offset;
+    }
+
+  private:
+    my_array<std::size_t, Rank> _extents;
+    my_array<std::size_t, Rank> _strides;
+  };
+
+  template <std::size_t... Extents> static constexpr std::size_t static_span_size() { return (Extents * ... * 1); }
+};
+
+// Rank-2 tiled layout: Block x Block tiles stored one after another in row-major tile order, row-major inside a
+// tile. Both row and column neighbours of an element are then usually on the same or an adjacent cache line. The
+// extents are padded up to whole tiles.
+template <std::size_t Block> struct layout_blocked {
+  static_assert(std::has_single_bit(Block), "Block must be a power of two");
+
+  template <std::size_t Rank> class mapping {
+    static_assert(Rank == 2, "layout_blocked is defined for matrices only");
+
+  public:
+    explicit mapping(const my_array<std::size_t, Rank> &extents)
+        : _extents(extents), _tiles_per_row((extents[1] + Block - 1) / Block) {}
+
+    const my_array<std::size_t, Rank> &extents() const noexcept { return _extents; }
+
+    std::size_t extent(std::size_t r) const noexcept { return _extents[r]; }
+
+    std::size_t required_span_size() const noexcept {
+      return (_extents[0] + Block - 1) / Block * _tiles_per_row * Block * Block;
+    }
+
+    std::size_t operator()(std::size_t i, std::size_t j) const noexcept {
+      return ((i / Block) * _tiles_per_row + j / Block) * (Block * Block) + (i % Block) * Block + j % Block;
+    }
+
+  private:
+    my_array<std::size_t, Rank> _extents;
+    std::size_t _tiles_per_row;
+  };
+
+  template <std::size_t Rows, std::size_t Cols> static constexpr std::size_t static_span_size() {
+    return (Rows + Block - 1) / Block * ((Cols + Block - 1) / Block) * Block * Block;
+  }
+};
+
+// Non-owning multidimensional view, the counterpart of std::mdspan<T, dextents<size_t, Rank>, Layout>. Element
+// access is operator()(i, j, ...) because multi-argument operator[] needs C++23.
+template <typename T, typename Layout, std::size_t Rank> class md_view {
+public:
+  using element_type = T;
+  using layout_type = Layout;
+  using mapping_type = typename Layout::template mapping<Rank>;
+
+  md_view(T *data, const mapping_type &map) : _data(data), _map(map) {}
+
+  static constexpr std::size_t rank() noexcept { return Rank; }
+
+  std::size_t extent(std::size_t r) const noexcept { return _map.extent(r); }
+
+  std::size_t size() const noexcept {
+    std::size_t n = 1;
+    for (std::size_t r = 0; r < Rank; ++r)
+      n *= _map.extent(r);
+    return n;
+  }
+
+  T *data_handle() const noexcept { return _data; }
+
+  const mapping_type &mapping() const noexcept { return _map; }
+
+  template <typename... I> T &operator()(I... indices) const noexcept { return _data[_map(indices...)]; }
+
+  template <typename U>
+    requires std::is_convertible_v<T (*)[], U (*)[]>
+  operator md_view<U, Layout, Rank>() const {
+    return md_view<U, Layout, Rank>(_data, _map);
+  }
+
+#if defined(__cpp_lib_mdspan)
+  // Only for the standard layouts, which std::mdspan understands directly.
+  auto to_mdspan() const
+    requires(std::is_same_v<Layout, layout_right> || std::is_same_v<Layout, layout_left>)
+  {
+    using std_layout = std::conditional_t<std::is_same_v<Layout, layout_right>, std::layout_right, std::layout_left>;
+    std::array<std::size_t, Rank> extents;
+    for (std::size_t r = 0; r < Rank; ++r)
+      extents[r] = _map.extent(r);
+    return std::mdspan<T, std::dextents<std::size_t, Rank>, std_layout>(_data, extents);
+  }
+#endif
+
+private:
+  T *_data;
+  mapping_type _map;
+};
+
+#endif // MD_VIEW_HPP
@@ -0,0 +1,151 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MDARRAY_HPP
+#define MDARRAY_HPP
+
+#include <array/my_array.hpp>
+#include <mdarray/md_view.hpp>
+#include <vector/my_vector.hpp>
+#include <cstddef>
+#include <stdexcept>
+
+// Owning multidimensional array with compile-time extents and layout, stored inline in a my_array sized by the
+// layout (tiled layouts pad to whole tiles).
+template <typename T, typename Layout, std::size_t... Extents> class basic_mdarray {
+  static constexpr std::size_t rank_value = sizeof...(Extents);
+  static constexpr std::size_t span_size = Layout::template static_span_size<Extents...>();
+
+public:
+  using view_type = md_view<T, Layout, rank_value>;
+  using const_view_type = md_view<const T, Layout, rank_value>;
+  using mapping_type = typename Layout::template mapping<rank_value>;
+
+  basic_mdarray() : _data(T()), _map(my_array<std::size_t, rank_value>(Extents...)) {}
+
+  explicit basic_mdarray(const T &value) : _data(value), _map(my_array<std::size_t, rank_value>(Extents...)) {}
+
+  static constexpr std::size_t rank() noexcept { return rank_value; }
+
+  static constexpr std::size_t static_extent(std::size_t r) noexcept {
+    constexpr std::size_t extents[] = {Extents...};
+    return extents[r];
+  }
+
+  std::size_t extent(std::size_t r) const noexcept { return _map.extent(r); }
+
+  static constexpr std::size_t size() noexcept { return (Extents * ... * 1); }
+
+  // Storage footprint in elements, including tile padding.
+  static constexpr std::size_t required_span_size() noexcept { return span_size; }
+
+  template <typename... I> T &operator()(I... indices) noexcept { return _data[_map(indices...)]; }
+
+  template <typename... I> const T &operator()(I... indices) const noexcept { return _data[_map(indices...)]; }
+
+  template <typename... I> T &at(I... indices) {
+    check_bounds(indices...);
+    return (*this)(indices...);
+  }
+
+  template <typename... I> const T &at(I... indices) const {
+    check_bounds(indices...);
+    return (*this)(indices...);
+  }
+
+  T *data() noexcept { return _data.data(); }
+
+  const T *data() const noexcept { return _data.data(); }
+
+  const mapping_type &mapping() const noexcept { return _map; }
+
+  view_type view() noexcept { return view_type(_data.data(), _map); }
+
+  const_view_type view() const noexcept { return const_view_type(_data.data(), _map); }
+
+  operator view_type() noexcept { return view(); }
+
+  operator const_view_type() const noexcept { return view(); }
+
+private:
+  template <typename... I> void check_bounds(I... indices) const {
+    static_assert(sizeof...(I) == rank_value, "wrong number of indices");
+    const std::size_t idx[] = {static_cast<std::size_t>(indices)...};
+    for (std::size_t r = 0; r < rank_value; ++r) {
+      if (idx[r] >= _map.extent(r))
+        throw std::out_of_range("mdarray::at");
+    }
+  }
+
+  my_array<T, span_size> _data;
+  mapping_type _map;
+};
+
+// Row-major mdarray, the common case; use basic_mdarray directly to pick another layout.
+template <typename T, std::size_t... Extents> using mdarray = basic_mdarray<T, layout_right, Extents...>;
+
+// Runtime-extent counterpart stored in a my_vector.
+template <typename T, std::size_t Rank, typename Layout = layout_right> class dynamic_mdarray {
+public:
+  using view_type = md_view<T, Layout, Rank>;
+  using const_view_type = md_view<const T, Layout, Rank>;
+  using mapping_type = typename Layout::template mapping<Rank>;
+
+  explicit dynamic_mdarray(const my_array<std::size_t, Rank> &extents, const T &value = T())
+      : _map(extents), _data(_map.required_span_size(), value) {}
+
+  static constexpr std::size_t rank() noexcept { return Rank; }
+
+  std::size_t extent(std::size_t r) const noexcept { return _map.extent(r); }
+
+  std::size_t size() const noexcept {
+    std::size_t n = 1;
+    for (std::size_t r = 0; r < Rank; ++r)
+      n *= _map.extent(r);
+    return n;
+  }
+
+  std::size_t required_span_size() const noexcept { return _data.size(); }
+
+  template <typename... I> T &operator()(I... indices) noexcept { return _data[_map(indices...)]; }
+
+  template <typename... I> const T &operator()(I... indices) const noexcept { return _data[_map(indices...)]; }
+
+  template <typename... I> T &at(I... indices) {
+    check_bounds(indices...);
+    return (*this)(indices...);
+  }
+
+  template <typename... I> const T &at(I... indices) const {
+    check_bounds(indices...);
+    return (*this)(indices...);
+  }
+
+  T *data() noexcept { return _data.data(); }
+
+  const T *data() const noexcept { return _data.data(); }
+
+  const mapping_type &mapping() const noexcept { return _map; }
+
+  view_type view() noexcept { return view_type(_data.data(), _map); }
+
+  const_view_type view() const noexcept { return const_view_type(_data.data(), _map); }
+
+  operator view_type() noexcept { return view(); }
+
+  operator const_view_type() const noexcept { return view(); }
+
+private:
+  template <typename... I> void check_bounds(I... indices) const {
+    static_assert(sizeof...(I) == Rank, "wrong number of indices");
+    const std::size_t idx[] = {static_cast<std::size_t>(indices)...};
+    for (std::size_t r = 0; r < Rank; ++r) {
+      if (idx[r] >= _map.extent(r))
+        throw std::out_of_range("dynamic_mdarray::at");
+    }
+  }
+
+  mapping_type _map;
+  my_vector<T> _data;
+};
+
+#endif // MDARRAY_HPP
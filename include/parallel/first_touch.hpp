@@ -0,0 +1,170 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef FIRST_TOUCH_HPP
+#define FIRST_TOUCH_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <thread>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// Opt-in parallel initialisation of large buffers. Linux places a page on the NUMA node of the thread that first
+// writes it, so constructing a huge buffer on one thread puts all of it on one node. Here the range is split into
+// one contiguous chunk per thread and every chunk is constructed by its own thread; processing the data later with
+// parallel_for() and the same policy makes each thread work on the pages it touched first.
+//
+// An explicit placement (interleave or bind) is a memory policy on pages, and it stays on them until they are
+// unmapped. It is therefore only applied to buffers that own their pages: large buffers from numa_allocate(), which
+// gets a dedicated mapping for them. Storage shared with other objects is placed by first touch alone.
+
+enum class numa_placement {
+  local,      // leave placement to first touch
+  interleave, // spread pages round-robin over all allowed nodes
+  bind        // put every page on parallel_init::node
+};
+
+struct parallel_init {
+  unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+  numa_placement placement = numa_placement::local;
+  int node = 0;
+  // Buffers smaller than this per thread are not worth a thread and are split over fewer threads.
+  size_t min_bytes_per_thread = size_t{1} << 20;
+  // Smaller buffers are not worth a mapping of their own and get no explicit placement.
+  size_t placement_min_bytes = size_t{2} << 20;
+};
+
+// Bounds of chunk index out of chunks over [0, n): the first n % chunks chunks get one extra element.
+inline std::pair<size_t, size_t> parallel_chunk(size_t index, size_t chunks, size_t n) noexcept {
+  const size_t base = n / chunks;
+  const size_t extra = n % chunks;
+  const size_t begin = index * base + std::min(index, extra);
+  return {begin, begin + base + (index < extra ? 1 : 0)};
+}
+
+inline unsigned parallel_thread_count(size_t n, size_t element_size, const parallel_init &init) noexcept {
+  const size_t by_size = n * element_size / std::max<size_t>(init.min_bytes_per_thread, 1);
+  return static_cast<unsigned>(std::clamp<size_t>(by_size, 1, std::max(1u, init.threads)));
+}
+
+namespace first_touch_detail {
+// Applies the placement policy to the page-aligned range [ptr, ptr + bytes). It is a hint: failures (no NUMA
+// support, a node outside the cpuset) leave the default policy in place.
+inline void apply_numa_placement(void *ptr, size_t bytes, const parallel_init &init) noexcept {
+#if defined(__linux__) && defined(SYS_mbind)
+  constexpr int mpol_bind = 2;
+  constexpr int mpol_interleave = 3;
+  unsigned long mask = ~0UL;
+  int mode = mpol_interleave;
+  if (init.placement == numa_placement::bind) {
+    if (init.node < 0 || init.node >= static_cast<int>(8 * sizeof(mask)))
+      return;
+    mode = mpol_bind;
+    mask = 1UL << init.node;
+  }
+  syscall(SYS_mbind, ptr, bytes, mode, &mask, 8 * sizeof(mask) + 1, 0);
+#else
+  (void)ptr;
+  (void)bytes;
+  (void)init;
+#endif
+}
+} // namespace first_touch_detail
+
+// A dedicated, page-aligned anonymous mapping of bytes bytes with init's placement policy applied to all of it, or
+// nullptr when init asks for local placement, the buffer is below init.placement_min_bytes or mapping fails (the
+// caller then falls back to its usual allocation). Nothing else lives on these pages, so the policy affects only
+// this buffer and goes away with it. Free with numa_deallocate(p, bytes).
+inline void *numa_allocate(size_t bytes, const parallel_init &init) noexcept {
+#if defined(__linux__)
+  if (init.placement == numa_placement::local || bytes < init.placement_min_bytes || bytes == 0)
+    return nullptr;
+  void *p = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (p == MAP_FAILED)
+    return nullptr;
+  first_touch_detail::apply_numa_placement(p, bytes, init);
+  return p;
+#else
+  (void)bytes;
+  (void)init;
+  return nullptr;
+#endif
+}
+
+inline void numa_deallocate(void *p, size_t bytes) noexcept {
+#if defined(__linux__)
+  munmap(p, bytes);
+#else
+  (void)p;
+  (void)bytes;
+#endif
+}
+
+// Runs fn(begin, end, chunk_index) for every chunk of [0, n), chunk 0 on the calling thread. The first exception
+// thrown by any chunk is rethrown after all threads have finished.
+template <typename F> void parallel_for(size_t n, unsigned threads, F &&fn) {
+  threads = std::max(1u, threads);
+  if (threads == 1) {
+    fn(size_t{0}, n, size_t{0});
+    return;
+  }
+  auto errors = std::make_unique<std::exception_ptr[]>(threads);
+  auto workers = std::make_unique<std::thread[]>(threads - 1);
+  unsigned started = 0;
+  auto run = [&](unsigned chunk) {
+    try {
+      const auto [begin, end] = parallel_chunk(chunk, threads, n);
+      fn(begin, end, size_t{chunk});
+    } catch (...) {
+      errors[chunk] = std::current_exception();
+    }
+  };
+  try {
+    for (; started < threads - 1; ++started)
+      workers[started] = std::thread(run, started + 1);
+  } catch (...) {
+    // Could not start a thread: the chunks that have no thread yet run here instead.
+    for (unsigned chunk = started + 1; chunk < threads; ++chunk)
+      run(chunk);
+  }
+  run(0);
+  for (unsigned i = 0; i < started; ++i)
+    workers[i].join();
+  for (unsigned i = 0; i < threads; ++i) {
+    if (errors[i])
+      std::rethrow_exception(errors[i]);
+  }
+}
+
+// Constructs n objects in raw storage at first with construct(chunk_first, chunk_count), one chunk per thread, so
+// that each thread touches its chunk's pages first. Either every object is constructed or, if any chunk throws, all
+// chunks that did succeed are destroyed again and the exception propagates.
+template <typename T, typename Construct>
+void parallel_uninitialized_construct(T *first, size_t n, const parallel_init &init, Construct construct) {
+  const unsigned threads = parallel_thread_count(n, sizeof(T), init);
+  auto done = std::make_unique<bool[]>(threads);
+  try {
+    parallel_for(n, threads, [&](size_t begin, size_t end, size_t chunk) {
+      construct(first + begin, end - begin);
+      done[chunk] = true;
+    });
+  } catch (...) {
+    for (unsigned chunk = 0; chunk < threads; ++chunk) {
+      if (done[chunk]) {
+        const auto [begin, end] = parallel_chunk(chunk, threads, n);
+        std::destroy(first + begin, first + end);
+      }
+    }
+    throw;
+  }
+}
+
+#endif // FIRST_TOUCH_HPP
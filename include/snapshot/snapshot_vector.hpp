@@ -0,0 +1,288 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef SNAPSHOT_VECTOR_HPP
+#define SNAPSHOT_VECTOR_HPP
+
+#include <concurrent/cache_line.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+// Versioned vector for read-mostly data shared between threads. Elements live in fixed-size chunks; a version is a
+// table of shared chunk pointers. The writer copies the chunk table, clones only the chunks it touches and publishes
+// the result with one atomic pointer exchange.
+//
+// Old versions are reclaimed epoch style. A reader pins the current epoch by incrementing a counter in one of
+// reader_stripes cache lines, picked per thread, and then loads the current version pointer: no lock, no shared
+// reference count and no copy. The writer retires replaced versions with the epoch they were replaced in, and on
+// every publish() (or reclaim()) advances the epoch once no reader is pinned in the one before; a version retired
+// in epoch e is freed, with every chunk no newer version shares, once the epoch reaches e + 2. A snapshot that is
+// held for long therefore delays the reclamation of every version retired after it was taken. Snapshots must not
+// outlive their snapshot_vector.
+template <typename T, size_t ChunkSize = 1024> class snapshot_vector {
+  static_assert(ChunkSize > 0, "ChunkSize must be positive");
+
+  static constexpr size_t reader_stripes = 16;
+
+  using chunk = my_vector<T>;
+
+  // The last chunk may hold more elements than size covers: writers pop from shared chunks without cloning them,
+  // so everything past size is stale and only the first size elements belong to the version.
+  struct version {
+    my_vector<std::shared_ptr<chunk>> chunks;
+    size_t size = 0;
+  };
+
+  // Elements of chunk c that lie inside the first size elements.
+  static size_t live_in_chunk(size_t c, size_t size) noexcept { return std::min(ChunkSize, size - c * ChunkSize); }
+
+  // Readers pinned in epochs of each parity. Only the two newest epochs can have readers, so the parity tells them
+  // apart.
+  struct alignas(cache_line_size) reader_stripe {
+    std::atomic<size_t> pinned[2] = {};
+  };
+
+  struct retired_version {
+    const version *v;
+    uint64_t epoch;
+  };
+
+  static size_t stripe_of_this_thread() noexcept {
+    static std::atomic<size_t> next{0};
+    static thread_local const size_t stripe = next.fetch_add(1, std::memory_order_relaxed) % reader_stripes;
+    return stripe;
+  }
+
+  static const version &empty_version() {
+    static const version empty;
+    return empty;
+  }
+
+public:
+  // Immutable view of one published version; keeps the epoch it was taken in pinned until it is destroyed.
+  class snapshot {
+  public:
+    snapshot() : _version(&empty_version()) {}
+
+    snapshot(const snapshot &other) noexcept : _version(other._version), _pin(other._pin) {
+      // The epoch cannot have moved past other's pin + 1, so the same parity still protects the version.
+      if (_pin)
+        _pin->fetch_add(1, std::memory_order_seq_cst);
+    }
+
+    snapshot(snapshot &&other) noexcept : _version(other._version), _pin(other._pin) { other._pin = nullptr; }
+
+    snapshot &operator=(snapshot other) noexcept {
+      std::swap(_version, other._version);
+      std::swap(_pin, other._pin);
+      return *this;
+    }
+
+    ~snapshot() {
+      if (_pin)
+        _pin->fetch_sub(1, std::memory_order_release);
+    }
+
+    size_t size() const noexcept { return _version->size; }
+
+    bool is_empty() const noexcept { return _version->size == 0; }
+
+    const T &operator[](size_t index) const noexcept {
+      return (*_version->chunks[index / ChunkSize])[index % ChunkSize];
+    }
+
+    const T &at(size_t index) const {
+      if (index >= size())
+        throw std::out_of_range("Index out of range");
+      return (*this)[index];
+    }
+
+    // Calls fn(const T *first, const T *last) once per chunk, in order.
+    template <typename F> void for_each_chunk(F &&fn) const {
+      for (size_t c = 0; c < _version->chunks.size(); ++c) {
+        const T *first = _version->chunks[c]->begin();
+        fn(first, first + live_in_chunk(c, _version->size));
+      }
+    }
+
+  private:
+    friend class snapshot_vector;
+
+    snapshot(const version *v, std::atomic<size_t> *pin) noexcept : _version(v), _pin(pin) {}
+
+    const version *_version;
+    std::atomic<size_t> *_pin = nullptr;
+  };
+
+  // Private working copy of the chunk table. Chunks inherited from the published version are shared with readers
+  // and are cloned on the first write through this writer; pop_back() only shrinks the size and does not count as
+  // a write.
+  class writer {
+  public:
+    size_t size() const noexcept { return _size; }
+
+    bool is_empty() const noexcept { return _size == 0; }
+
+    const T &operator[](size_t index) const noexcept { return (*_chunks[index / ChunkSize])[index % ChunkSize]; }
+
+    T &mutable_at(size_t index) {
+      if (index >= _size)
+        throw std::out_of_range("Index out of range");
+      return (*owned_chunk(index / ChunkSize))[index % ChunkSize];
+    }
+
+    void set(size_t index, const T &value) { mutable_at(index) = value; }
+
+    void push_back(const T &value) {
+      if (_size % ChunkSize == 0) {
+        auto fresh = std::make_shared<chunk>();
+        fresh->reserve(ChunkSize);
+        _chunks.push_back(std::move(fresh));
+        _owned.push_back(1);
+      }
+      owned_chunk(_chunks.size() - 1)->push_back(value);
+      ++_size;
+    }
+
+    void pop_back() {
+      if (_size == 0)
+        return;
+      if (_owned.back())
+        _chunks.back()->pop_back();
+      if (--_size % ChunkSize == 0) {
+        _chunks.pop_back();
+        _owned.pop_back();
+      }
+    }
+
+    void clear() {
+      _chunks.clear();
+      _owned.clear();
+      _size = 0;
+    }
+
+  private:
+    friend class snapshot_vector;
+
+    explicit writer(const version &base) : _chunks(base.chunks), _owned(base.chunks.size(), 0), _size(base.size) {}
+
+    // Clones only the elements still inside the writer's size.
+    chunk *owned_chunk(size_t c) {
+      if (!_owned[c]) {
+        auto copy = std::make_shared<chunk>();
+        copy->reserve(ChunkSize);
+        const T *first = _chunks[c]->begin();
+        copy->insert(copy->end(), first, first + live_in_chunk(c, _size));
+        _chunks[c] = std::move(copy);
+        _owned[c] = 1;
+      }
+      return _chunks[c].get();
+    }
+
+    my_vector<std::shared_ptr<chunk>> _chunks;
+    my_vector<unsigned char> _owned;
+    size_t _size;
+  };
+
+  snapshot_vector() : _current(new version()) {}
+
+  template <std::forward_iterator II> snapshot_vector(II first, II last) : snapshot_vector() {
+    writer w = begin_write();
+    for (; first != last; ++first)
+      w.push_back(*first);
+    publish(std::move(w));
+  }
+
+  snapshot_vector(const snapshot_vector &) = delete;
+
+  snapshot_vector &operator=(const snapshot_vector &) = delete;
+
+  // Every snapshot must be gone by now.
+  ~snapshot_vector() {
+    for (const retired_version &r : _retired)
+      delete r.v;
+    delete _current.load(std::memory_order_relaxed);
+  }
+
+  // Lock-free and wait-free unless a publish() advances the epoch between the reader's two epoch loads, which
+  // makes it retry. Readers on different threads mostly touch different stripes.
+  snapshot load() const noexcept {
+    std::atomic<size_t> *pin;
+    for (;;) {
+      const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+      pin = &_stripes[stripe_of_this_thread()].pinned[epoch & 1];
+      pin->fetch_add(1, std::memory_order_seq_cst);
+      if (_epoch.load(std::memory_order_seq_cst) == epoch)
+        break;
+      pin->fetch_sub(1, std::memory_order_relaxed);
+    }
+    return snapshot(_current.load(std::memory_order_seq_cst), pin);
+  }
+
+  size_t size() const noexcept { return load().size(); }
+
+  // Writers built with begin_write()/publish()/reclaim() must be serialised by the caller; update() does that
+  // itself.
+  writer begin_write() const { return writer(*_current.load(std::memory_order_acquire)); }
+
+  void publish(writer &&w) {
+    auto next = std::make_unique<version>();
+    next->chunks.swap(w._chunks);
+    next->size = w._size;
+    w.clear();
+    _retired.reserve(_retired.size() + 1);
+    const version *old = _current.exchange(next.release(), std::memory_order_seq_cst);
+    _retired.push_back({old, _epoch.load(std::memory_order_seq_cst)});
+    reclaim();
+  }
+
+  // Frees the retired versions no reader can still see, advancing the epoch as far as the readers allow.
+  void reclaim() {
+    while (try_advance_epoch() && !_retired.is_empty() &&
+           _retired.back().epoch + 2 > _epoch.load(std::memory_order_relaxed)) {
+    }
+    const uint64_t epoch = _epoch.load(std::memory_order_relaxed);
+    _retired.erase_if([epoch](const retired_version &r) {
+      if (r.epoch + 2 > epoch)
+        return false;
+      delete r.v;
+      return true;
+    });
+  }
+
+  // Versions replaced but not yet freed.
+  size_t retired_count() const noexcept { return _retired.size(); }
+
+  template <typename F> void update(F &&fn) {
+    std::lock_guard<std::mutex> lock(_writer_mutex);
+    writer w = begin_write();
+    fn(w);
+    publish(std::move(w));
+  }
+
+private:
+  // Moves from epoch e to e + 1 once no reader is pinned in e - 1, the other epoch of e + 1's parity.
+  bool try_advance_epoch() {
+    const uint64_t epoch = _epoch.load(std::memory_order_seq_cst);
+    for (const reader_stripe &stripe : _stripes) {
+      if (stripe.pinned[(epoch + 1) & 1].load(std::memory_order_seq_cst) != 0)
+        return false;
+    }
+    _epoch.store(epoch + 1, std::memory_order_seq_cst);
+    return true;
+  }
+
+  std::atomic<const version *> _current;
+  std::atomic<uint64_t> _epoch{0};
+  mutable reader_stripe _stripes[reader_stripes];
+  my_vector<retired_version> _retired;
+  std::mutex _writer_mutex;
+};
+
+#endif // SNAPSHOT_VECTOR_HPP
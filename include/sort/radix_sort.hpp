@@ -0,0 +1,263 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef RADIX_SORT_HPP
+#define RADIX_SORT_HPP
+
+#include <parallel/first_touch.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+
+// Sorting for my_vector. Elements are ordered by an unsigned "radix key" taken from each of them:
+//  * radix_sort() is a stable LSD radix sort over 8-bit digits. All digit histograms come from a single pass, digits
+//    that are the same in every element are skipped, and the elements ping-pong between the vector and one scratch
+//    buffer that the caller can keep and reuse across calls. Large inputs are first split on their most significant
+//    varying digit so that the LSD passes run on cache-sized buckets;
+//  * parallel_radix_sort() does that split in parallel and stably, and then sorts the buckets on all threads;
+//  * adaptive_sort() picks one of them for types with a radix key and falls back to std::sort for everything else.
+
+template <typename K>
+concept radix_key_type = (std::integral<K> && !std::is_same_v<K, bool>) ||
+                         (std::floating_point<K> && (sizeof(K) == 4 || sizeof(K) == 8));
+
+// Order-preserving map of a number to an unsigned integer of the same width: signed integers get their sign bit
+// flipped, floating-point numbers get all bits flipped when negative and only the sign bit otherwise. Negative NaNs
+// therefore sort first, positive NaNs last, and -0.0 before +0.0.
+template <radix_key_type K> constexpr auto radix_bits(K key) noexcept {
+  if constexpr (std::floating_point<K>) {
+    using U = std::conditional_t<sizeof(K) == 4, uint32_t, uint64_t>;
+    const U bits = std::bit_cast<U>(key);
+    constexpr U sign = U{1} << (8 * sizeof(U) - 1);
+    return (bits & sign) ? static_cast<U>(~bits) : static_cast<U>(bits | sign);
+  } else {
+    using U = std::make_unsigned_t<K>;
+    auto bits = static_cast<U>(key);
+    if constexpr (std::is_signed_v<K>)
+      bits ^= U{1} << (8 * sizeof(U) - 1);
+    return bits;
+  }
+}
+
+// Key used when none is given: numbers are their own key, and pairs of integers of up to 32 bits sort
+// lexicographically as one 64-bit key.
+struct radix_default_key {
+  template <radix_key_type K> constexpr K operator()(K key) const noexcept { return key; }
+
+  template <radix_key_type A, radix_key_type B>
+    requires(std::integral<A> && std::integral<B> && sizeof(A) <= 4 && sizeof(B) <= 4)
+  constexpr uint64_t operator()(const std::pair<A, B> &p) const noexcept {
+    return uint64_t{radix_bits(p.first)} << 32 | radix_bits(p.second);
+  }
+};
+
+template <typename T, typename KeyFn>
+concept radix_sortable = requires(const T &value, const KeyFn &key) {
+  { key(value) } -> radix_key_type;
+};
+
+namespace radix_sort_detail {
+constexpr unsigned digit_bits = 8;
+constexpr size_t buckets = size_t{1} << digit_bits;
+constexpr size_t digit_mask = buckets - 1;
+// Below this many elements a radix pass costs more than insertion sort.
+constexpr size_t insertion_threshold = 64;
+// Above this many bytes radix_sort() starts with an MSD pass.
+constexpr size_t msd_threshold_bytes = size_t{1} << 20;
+
+template <typename T, typename KeyFn>
+using key_bits_t = decltype(radix_bits(std::declval<const KeyFn &>()(std::declval<const T &>())));
+
+template <typename T, typename KeyFn> void insertion_sort(T *first, T *last, const KeyFn &key) {
+  if (first == last)
+    return;
+  for (T *i = first + 1; i != last; ++i) {
+    T value = std::move(*i);
+    const auto k = radix_bits(key(value));
+    T *j = i;
+    for (; j != first && k < radix_bits(key(*(j - 1))); --j)
+      *j = std::move(*(j - 1));
+    *j = std::move(value);
+  }
+}
+
+// Sorts [first, last) on the key bits below `bits`, using buffer (of the same length) as scratch. Returns true when
+// the sorted elements ended up in buffer instead of [first, last).
+template <typename T, typename KeyFn> bool lsd_sort(T *first, T *last, T *buffer, unsigned bits, const KeyFn &key) {
+  using K = key_bits_t<T, KeyFn>;
+  const auto n = static_cast<size_t>(last - first);
+  const unsigned digits = (bits + digit_bits - 1) / digit_bits;
+  size_t counts[sizeof(K)][buckets] = {};
+  for (const T *p = first; p != last; ++p) {
+    const K k = radix_bits(key(*p));
+    for (unsigned d = 0; d < digits; ++d)
+      ++counts[d][(k >> (d * digit_bits)) & digit_mask];
+  }
+  T *src = first;
+  T *dst = buffer;
+  bool in_buffer = false;
+  for (unsigned d = 0; d < digits; ++d) {
+    const unsigned shift = d * digit_bits;
+    size_t *offsets = counts[d];
+    // A digit shared by every element would not move anything.
+    if (offsets[(radix_bits(key(*src)) >> shift) & digit_mask] == n)
+      continue;
+    size_t offset = 0;
+    for (size_t b = 0; b < buckets; ++b)
+      offset += std::exchange(offsets[b], offset);
+    for (T *p = src; p != src + n; ++p)
+      dst[offsets[(radix_bits(key(*p)) >> shift) & digit_mask]++] = std::move(*p);
+    std::swap(src, dst);
+    in_buffer = !in_buffer;
+  }
+  return in_buffer;
+}
+
+// Sorts data[0, n) with one most-significant-digit pass followed by lsd_sort() of every bucket, using buffer (of
+// length n) as scratch; the result is always in data. The MSD pass finds which key bits vary at all and splits the
+// elements into up to 256 buckets on the top 8 of those bits, so the LSD passes only see the bits below them and
+// work on ranges small enough to stay in cache. With several threads each one counts its own chunk, and the
+// per-(bucket, chunk) offsets let every thread scatter its chunk without synchronisation, which keeps the pass
+// stable; the buckets are then sorted largest first by whichever thread is free.
+template <typename T, typename KeyFn>
+void msd_lsd_sort(T *data, T *buffer, size_t n, unsigned threads, const KeyFn &key) {
+  using K = key_bits_t<T, KeyFn>;
+  const K first_key = radix_bits(key(data[0]));
+  auto varying = std::make_unique<K[]>(threads);
+  parallel_for(n, threads, [&](size_t begin, size_t end, size_t chunk) {
+    K diff = 0;
+    for (size_t i = begin; i < end; ++i)
+      diff |= radix_bits(key(data[i])) ^ first_key;
+    varying[chunk] = diff;
+  });
+  const K diff = std::accumulate(varying.get(), varying.get() + threads, K{0}, std::bit_or<>());
+  if (diff == 0)
+    return;
+  const auto width = static_cast<unsigned>(std::bit_width(diff));
+  const unsigned shift = width > digit_bits ? width - digit_bits : 0;
+
+  auto offsets = std::make_unique<size_t[]>(threads * buckets);
+  parallel_for(n, threads, [&](size_t begin, size_t end, size_t chunk) {
+    size_t *count = &offsets[chunk * buckets];
+    for (size_t i = begin; i < end; ++i)
+      ++count[(radix_bits(key(data[i])) >> shift) & digit_mask];
+  });
+  size_t bucket_begin[buckets + 1];
+  size_t offset = 0;
+  for (size_t b = 0; b < buckets; ++b) {
+    bucket_begin[b] = offset;
+    for (unsigned chunk = 0; chunk < threads; ++chunk)
+      offset += std::exchange(offsets[chunk * buckets + b], offset);
+  }
+  bucket_begin[buckets] = n;
+  parallel_for(n, threads, [&](size_t begin, size_t end, size_t chunk) {
+    size_t *next = &offsets[chunk * buckets];
+    for (size_t i = begin; i < end; ++i)
+      buffer[next[(radix_bits(key(data[i])) >> shift) & digit_mask]++] = std::move(data[i]);
+  });
+
+  size_t order[buckets];
+  std::iota(order, order + buckets, size_t{0});
+  std::sort(order, order + buckets, [&](size_t a, size_t b) {
+    return bucket_begin[a + 1] - bucket_begin[a] > bucket_begin[b + 1] - bucket_begin[b];
+  });
+  std::atomic<size_t> next_bucket{0};
+  parallel_for(threads, threads, [&](size_t, size_t, size_t) {
+    for (size_t i = next_bucket.fetch_add(1, std::memory_order_relaxed); i < buckets;
+         i = next_bucket.fetch_add(1, std::memory_order_relaxed)) {
+      const size_t begin = bucket_begin[order[i]];
+      const size_t end = bucket_begin[order[i] + 1];
+      if (end - begin < insertion_threshold) {
+        std::move(buffer + begin, buffer + end, data + begin);
+        insertion_sort(data + begin, data + end, key);
+      } else if (!lsd_sort(buffer + begin, buffer + end, data + begin, shift, key)) {
+        std::move(buffer + begin, buffer + end, data + begin);
+      }
+    }
+  });
+}
+} // namespace radix_sort_detail
+
+// Stable radix sort of v by key(element). scratch is grown to v.size() if it is smaller and is otherwise reused as
+// is; on return it holds unspecified elements (when the last pass lands in scratch the two buffers are swapped
+// instead of copied back). Inputs larger than msd_threshold_bytes get an MSD pass first, because LSD passes over a
+// range much larger than the cache scatter into 256 streams that all miss.
+template <typename T, typename KeyFn = radix_default_key>
+  requires radix_sortable<T, KeyFn>
+void radix_sort(my_vector<T> &v, my_vector<T> &scratch, KeyFn key = {}) {
+  using namespace radix_sort_detail;
+  const size_t n = v.size();
+  if (n < insertion_threshold) {
+    insertion_sort(v.begin(), v.end(), key);
+    return;
+  }
+  if (scratch.size() < n)
+    scratch.resize(n);
+  if (n * sizeof(T) > msd_threshold_bytes) {
+    msd_lsd_sort(v.begin(), scratch.begin(), n, 1, key);
+  } else if (lsd_sort(v.begin(), v.end(), scratch.begin(), 8 * sizeof(key_bits_t<T, KeyFn>), key)) {
+    if (scratch.size() == n)
+      v.swap(scratch);
+    else
+      std::move(scratch.begin(), scratch.begin() + n, v.begin());
+  }
+}
+
+template <typename T, typename KeyFn = radix_default_key>
+  requires radix_sortable<T, KeyFn>
+void radix_sort(my_vector<T> &v, KeyFn key = {}) {
+  my_vector<T> scratch;
+  radix_sort(v, scratch, key);
+}
+
+// Stable parallel radix sort: the MSD pass of radix_sort() split over threads, then the buckets sorted on all
+// threads. Inputs too small for more than one thread under init.min_bytes_per_thread go to radix_sort(). scratch is
+// first touched by the same threads (see parallel_init). key is called concurrently and must be safe to call so.
+template <typename T, typename KeyFn = radix_default_key>
+  requires radix_sortable<T, KeyFn>
+void parallel_radix_sort(my_vector<T> &v, my_vector<T> &scratch, const parallel_init &init = {}, KeyFn key = {}) {
+  using namespace radix_sort_detail;
+  const size_t n = v.size();
+  const unsigned threads = parallel_thread_count(n, sizeof(T), init);
+  if (threads == 1 || n < insertion_threshold) {
+    radix_sort(v, scratch, key);
+    return;
+  }
+  if (scratch.size() < n)
+    scratch.resize(n, init);
+  msd_lsd_sort(v.begin(), scratch.begin(), n, threads, key);
+}
+
+template <typename T, typename KeyFn = radix_default_key>
+  requires radix_sortable<T, KeyFn>
+void parallel_radix_sort(my_vector<T> &v, const parallel_init &init = {}, KeyFn key = {}) {
+  my_vector<T> scratch;
+  parallel_radix_sort(v, scratch, init, key);
+}
+
+// Sorts v ascending: radix sort (parallel for large inputs) when the elements have a default radix key, std::sort
+// otherwise. Floating-point results differ from std::sort only where operator< is not a strict weak order (NaNs)
+// and in the relative order of -0.0 and +0.0.
+template <typename T> void adaptive_sort(my_vector<T> &v, const parallel_init &init = {}) {
+  if constexpr (radix_sortable<T, radix_default_key>)
+    parallel_radix_sort(v, init);
+  else
+    std::sort(v.begin(), v.end());
+}
+
+// Comparison-sort fallback for a custom order.
+template <typename T, typename Compare>
+  requires std::strict_weak_order<Compare &, const T &, const T &>
+void adaptive_sort(my_vector<T> &v, Compare comp) {
+  std::sort(v.begin(), v.end(), comp);
+}
+
+#endif // RADIX_SORT_HPP
@@ -0,0 +1,70 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef MY_SPAN_HPP
+#define MY_SPAN_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+// Non-owning view of a contiguous run of elements. my_vector and my_array convert to it implicitly.
+template <typename T> class my_span {
+public:
+  static constexpr std::size_t npos = static_cast<std::size_t>(-1);
+
+  constexpr my_span() noexcept = default;
+
+  constexpr my_span(T *data, std::size_t size) noexcept : _data(data), _size(size) {}
+
+  // A template so that a literal 0 count picks the constructor above instead of being read as a null end pointer.
+  template <typename P>
+    requires(std::is_pointer_v<P> && std::is_convertible_v<P, T *>)
+  constexpr my_span(T *first, P last) noexcept : _data(first), _size(static_cast<T *>(last) - first) {}
+
+  template <typename U>
+    requires std::is_convertible_v<U (*)[], T (*)[]>
+  constexpr my_span(const my_span<U> &other) noexcept : _data(other.data()), _size(other.size()) {}
+
+  constexpr T *data() const noexcept { return _data; }
+
+  constexpr std::size_t size() const noexcept { return _size; }
+
+  constexpr std::size_t size_bytes() const noexcept { return _size * sizeof(T); }
+
+  constexpr bool is_empty() const noexcept { return _size == 0; }
+
+  constexpr T &operator[](std::size_t index) const noexcept { return _data[index]; }
+
+  constexpr T &at(std::size_t index) const {
+    if (index >= _size)
+      throw std::out_of_range("my_span::at");
+    return _data[index];
+  }
+
+  constexpr T &front() const noexcept { return _data[0]; }
+
+  constexpr T &back() const noexcept { return _data[_size - 1]; }
+
+  constexpr T *begin() const noexcept { return _data; }
+
+  constexpr T *end() const noexcept { return _data + _size; }
+
+  constexpr std::reverse_iterator<T *> rbegin() const noexcept { return std::reverse_iterator<T *>(end()); }
+
+  constexpr std::reverse_iterator<T *> rend() const noexcept { return std::reverse_iterator<T *>(begin()); }
+
+  constexpr my_span first(std::size_t count) const noexcept { return my_span(_data, count); }
+
+  constexpr my_span last(std::size_t count) const noexcept { return my_span(_data + _size - count, count); }
+
+  constexpr my_span subspan(std::size_t offset, std::size_t count = npos) const noexcept {
+    return my_span(_data + offset, count == npos ? _size - offset : count);
+  }
+
+private:
+  T *_data = nullptr;
+  std::size_t _size = 0;
+};
+
+#endif // MY_SPAN_HPP
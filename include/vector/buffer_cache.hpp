@@ -0,0 +1,211 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef BUFFER_CACHE_HPP
+#define BUFFER_CACHE_HPP
+
+#include <bit>
+#include <chrono>
+#include <cstddef>
+#include <new>
+
+// Opt-in, per-thread recycling of my_vector storage. While a buffer_cache_scope is open on a thread, every buffer
+// my_vector allocates on that thread is rounded up to a power of two and taken from the thread's free list for that
+// size class when one is there; the vector marks the buffer with buffer_cache_deallocate, so freeing it (on any
+// thread) puts it back on the freeing thread's list instead of calling ::operator delete, if that thread has a scope
+// open and room left. Buffers over max_block_bytes are allocated at their exact size and freed plainly, whatever
+// limits are in force when they are freed. The lists are bounded by buffer_cache_limits::max_bytes, and size classes
+// that saw no allocation for idle_after are trimmed, checked every so many cache operations or when the thread calls
+// buffer_cache_trim_idle(); everything left is freed when the last scope on the thread closes.
+//
+// Scopes must not be opened or closed from inside element constructors: a buffer's size class is decided when it
+// is allocated and its deallocator when the vector installs it, and the two must agree.
+
+struct buffer_cache_limits {
+  size_t max_bytes = size_t{4} << 20;      // total bytes kept on the thread's free lists
+  size_t max_block_bytes = size_t{1} << 20; // larger buffers bypass the cache
+  std::chrono::milliseconds idle_after{100};
+};
+
+struct buffer_cache_stats {
+  size_t hits = 0;          // allocations served from a free list
+  size_t misses = 0;        // allocations that went to ::operator new
+  size_t recycled = 0;      // frees that kept the block
+  size_t dropped = 0;       // frees that found the lists full
+  size_t trimmed_bytes = 0; // bytes released by idle trimming
+  size_t cached_bytes = 0;  // bytes on the free lists now
+};
+
+namespace buffer_cache_detail {
+constexpr unsigned min_class = 4; // 16-byte blocks, enough for the free-list link
+constexpr unsigned classes = 8 * sizeof(size_t);
+// Idle trimming looks at the clock once per this many cache operations.
+constexpr size_t clock_check_interval = 1024;
+
+inline unsigned size_class(size_t bytes) noexcept {
+  return bytes <= (size_t{1} << min_class) ? min_class : static_cast<unsigned>(std::bit_width(bytes - 1));
+}
+
+struct free_block {
+  free_block *next;
+};
+
+struct thread_cache {
+  buffer_cache_limits limits;
+  buffer_cache_stats stats;
+  unsigned depth = 0;
+  free_block *heads[classes] = {};
+  bool used[classes] = {};
+  size_t operations = 0;
+  std::chrono::steady_clock::time_point last_check{};
+
+  thread_cache() = default;
+
+  thread_cache(const thread_cache &) = delete;
+
+  thread_cache &operator=(const thread_cache &) = delete;
+
+  ~thread_cache() { release_all(); }
+
+  size_t release_class(unsigned cls) noexcept {
+    size_t bytes = 0;
+    while (free_block *block = heads[cls]) {
+      heads[cls] = block->next;
+      ::operator delete(block);
+      bytes += size_t{1} << cls;
+    }
+    stats.cached_bytes -= bytes;
+    return bytes;
+  }
+
+  void release_all() noexcept {
+    for (unsigned cls = 0; cls < classes; ++cls)
+      release_class(cls);
+  }
+
+  void maybe_trim() noexcept {
+    if (++operations % clock_check_interval == 0)
+      trim_idle();
+  }
+
+  // Frees the size classes that were not allocated from since the last check, if that was idle_after ago.
+  void trim_idle() noexcept {
+    const auto now = std::chrono::steady_clock::now();
+    if (now - last_check < limits.idle_after)
+      return;
+    for (unsigned cls = 0; cls < classes; ++cls) {
+      if (!used[cls])
+        stats.trimmed_bytes += release_class(cls);
+      used[cls] = false;
+    }
+    last_check = now;
+  }
+};
+
+// The flag is separate from the cache so that threads that never open a scope only read a plain thread_local bool.
+inline thread_local bool enabled = false;
+
+inline thread_cache &local_cache() {
+  static thread_local thread_cache cache;
+  return cache;
+}
+} // namespace buffer_cache_detail
+
+inline bool buffer_cache_enabled() noexcept { return buffer_cache_detail::enabled; }
+
+// Whether buffer_cache_allocate(bytes) on the calling thread returns a block of its whole size class right now,
+// which is what buffer_cache_deallocate relies on.
+inline bool buffer_cache_recyclable(size_t bytes) noexcept {
+  return buffer_cache_detail::enabled && bytes <= buffer_cache_detail::local_cache().limits.max_block_bytes;
+}
+
+// Returns at least bytes bytes, from the calling thread's cache when it is enabled. Free with
+// buffer_cache_deallocate(p, bytes) if buffer_cache_recyclable(bytes) held when it was allocated, and with
+// ::operator delete(p) otherwise.
+inline void *buffer_cache_allocate(size_t bytes) {
+  using namespace buffer_cache_detail;
+  if (!enabled)
+    return ::operator new(bytes);
+  thread_cache &cache = local_cache();
+  if (bytes > cache.limits.max_block_bytes)
+    return ::operator new(bytes);
+  const unsigned cls = size_class(bytes);
+  cache.used[cls] = true;
+  cache.maybe_trim();
+  if (free_block *block = cache.heads[cls]) {
+    cache.heads[cls] = block->next;
+    cache.stats.cached_bytes -= size_t{1} << cls;
+    ++cache.stats.hits;
+    return block;
+  }
+  ++cache.stats.misses;
+  return ::operator new(size_t{1} << cls);
+}
+
+// Deallocator for buffers from buffer_cache_allocate(bytes) made while buffer_cache_recyclable(bytes) held; bytes
+// is the size that was requested, not the rounded one. Such a buffer always spans its whole size class, so the
+// freeing thread's limits only decide whether it is kept, never whether it is big enough to be.
+inline void buffer_cache_deallocate(void *p, size_t bytes) noexcept {
+  using namespace buffer_cache_detail;
+  if (enabled) {
+    thread_cache &cache = local_cache();
+    const unsigned cls = size_class(bytes);
+    if (bytes <= cache.limits.max_block_bytes) {
+      if (cache.stats.cached_bytes + (size_t{1} << cls) <= cache.limits.max_bytes) {
+        auto *block = static_cast<free_block *>(p);
+        block->next = cache.heads[cls];
+        cache.heads[cls] = block;
+        cache.stats.cached_bytes += size_t{1} << cls;
+        ++cache.stats.recycled;
+        cache.maybe_trim();
+        return;
+      }
+      ++cache.stats.dropped;
+    }
+  }
+  ::operator delete(p);
+}
+
+// Frees every block on the calling thread's lists, e.g. from an idle hook.
+inline void buffer_cache_trim() noexcept {
+  if (buffer_cache_detail::enabled)
+    buffer_cache_detail::local_cache().release_all();
+}
+
+// Idle hook: frees the size classes the calling thread has not allocated from since the last idle check, if that was
+// at least idle_after ago. Threads that stop using the cache do not reach the periodic checks and call this instead.
+inline void buffer_cache_trim_idle() noexcept {
+  if (buffer_cache_detail::enabled)
+    buffer_cache_detail::local_cache().trim_idle();
+}
+
+inline buffer_cache_stats buffer_cache_thread_stats() {
+  return buffer_cache_detail::enabled ? buffer_cache_detail::local_cache().stats : buffer_cache_stats{};
+}
+
+// Enables the calling thread's cache for its lifetime. Scopes nest; the limits of the outermost one apply.
+class buffer_cache_scope {
+public:
+  explicit buffer_cache_scope(const buffer_cache_limits &limits = {}) {
+    buffer_cache_detail::thread_cache &cache = buffer_cache_detail::local_cache();
+    if (cache.depth++ == 0) {
+      cache.limits = limits;
+      cache.stats = {};
+      cache.last_check = std::chrono::steady_clock::now();
+      buffer_cache_detail::enabled = true;
+    }
+  }
+
+  buffer_cache_scope(const buffer_cache_scope &) = delete;
+
+  buffer_cache_scope &operator=(const buffer_cache_scope &) = delete;
+
+  ~buffer_cache_scope() {
+    buffer_cache_detail::thread_cache &cache = buffer_cache_detail::local_cache();
+    if (--cache.depth == 0) {
+      buffer_cache_detail::enabled = false;
+      cache.release_all();
+    }
+  }
+};
+
+#endif // BUFFER_CACHE_HPP
@@ -0,0 +1,181 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef CAPACITY_SITE_HPP
+#define CAPACITY_SITE_HPP
+
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <source_location>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+// Capacity learning for my_vector. A capacity_site stands for one place in the code that builds vectors whose final
+// size is predictable but not known up front. Vectors constructed from the site start at the capacity it suggests,
+// and report back their size when they are cleared or destroyed. The suggestion is the largest size seen in the
+// power-of-two size class that holds the 90th percentile of recent reports, so one outlier neither wastes memory on
+// every later vector nor makes most of them reallocate.
+
+struct capacity_site_stats {
+  size_t vectors = 0;       // lifetimes reported (destruction, clear() or release())
+  size_t hits = 0;          // of those, how many never reallocated
+  size_t reallocations = 0; // reallocations that still happened
+  // Reallocations a plain my_vector growing by doubling from capacity 1 would have made for the reported sizes,
+  // minus the ones that did happen.
+  size_t reallocations_avoided = 0;
+  size_t suggested_capacity = 0;
+
+  double hit_rate() const noexcept { return vectors ? static_cast<double>(hits) / static_cast<double>(vectors) : 0.0; }
+};
+
+class capacity_site {
+public:
+  explicit capacity_site(std::string name = {}) : _name(std::move(name)) {}
+
+  capacity_site(const capacity_site &) = delete;
+
+  capacity_site &operator=(const capacity_site &) = delete;
+
+  const std::string &name() const noexcept { return _name; }
+
+  size_t suggested_capacity() const noexcept { return _suggested.load(std::memory_order_relaxed); }
+
+  void note_reallocation() noexcept { _reallocations.fetch_add(1, std::memory_order_relaxed); }
+
+  // Reports the final size of one vector. Empty vectors that never grew were not used and are ignored.
+  void record(size_t final_size, bool reallocated) noexcept {
+    if (final_size == 0 && !reallocated)
+      return;
+    _vectors.fetch_add(1, std::memory_order_relaxed);
+    if (!reallocated)
+      _hits.fetch_add(1, std::memory_order_relaxed);
+    _baseline_reallocations.fetch_add(final_size > 1 ? std::bit_width(final_size - 1) : 0, std::memory_order_relaxed);
+
+    const auto cls = static_cast<size_t>(std::bit_width(final_size));
+    _counts[cls].fetch_add(1, std::memory_order_relaxed);
+    size_t seen = _class_max[cls].load(std::memory_order_relaxed);
+    while (seen < final_size && !_class_max[cls].compare_exchange_weak(seen, final_size, std::memory_order_relaxed)) {
+    }
+    // Halving the counts every window makes old reports fade so the suggestion follows a changing workload. The
+    // halving is a CAS per count so that reports racing with it are not lost.
+    if ((_window.fetch_add(1, std::memory_order_relaxed) + 1) % decay_window == 0) {
+      for (auto &count : _counts) {
+        size_t c = count.load(std::memory_order_relaxed);
+        while (!count.compare_exchange_weak(c, c / 2, std::memory_order_relaxed)) {
+        }
+      }
+    }
+    _suggested.store(percentile_capacity(), std::memory_order_relaxed);
+  }
+
+  capacity_site_stats stats() const noexcept {
+    capacity_site_stats s;
+    s.vectors = _vectors.load(std::memory_order_relaxed);
+    s.hits = _hits.load(std::memory_order_relaxed);
+    s.reallocations = _reallocations.load(std::memory_order_relaxed);
+    const size_t baseline = _baseline_reallocations.load(std::memory_order_relaxed);
+    s.reallocations_avoided = baseline > s.reallocations ? baseline - s.reallocations : 0;
+    s.suggested_capacity = suggested_capacity();
+    return s;
+  }
+
+private:
+  static constexpr size_t size_classes = 65; // class c holds sizes with std::bit_width(size) == c
+  static constexpr size_t decay_window = 1024;
+
+  size_t percentile_capacity() const noexcept {
+    size_t total = 0;
+    for (const auto &count : _counts)
+      total += count.load(std::memory_order_relaxed);
+    const size_t target = total - total / 10;
+    size_t cumulative = 0;
+    for (size_t cls = 0; cls < size_classes; ++cls) {
+      cumulative += _counts[cls].load(std::memory_order_relaxed);
+      if (cumulative >= target && cumulative > 0)
+        return _class_max[cls].load(std::memory_order_relaxed);
+    }
+    return 0;
+  }
+
+  std::string _name;
+  std::atomic<size_t> _suggested{0};
+  std::atomic<size_t> _vectors{0};
+  std::atomic<size_t> _hits{0};
+  std::atomic<size_t> _reallocations{0};
+  std::atomic<size_t> _baseline_reallocations{0};
+  std::atomic<size_t> _window{0};
+  std::atomic<size_t> _counts[size_classes] = {};
+  std::atomic<size_t> _class_max[size_classes] = {};
+};
+
+namespace capacity_site_detail {
+struct registry {
+  std::mutex mutex;
+  std::map<std::string, std::unique_ptr<capacity_site>, std::less<>> by_name;
+  // source_location::file_name() pointers are stable but may differ between translation units for the same file,
+  // so they only serve as a shortcut in front of by_name.
+  std::map<std::tuple<const char *, uint_least32_t, uint_least32_t>, capacity_site *> by_location;
+};
+
+inline registry &global_registry() {
+  static registry r;
+  return r;
+}
+
+inline capacity_site &find_or_add(registry &r, std::string_view name) {
+  auto it = r.by_name.find(name);
+  if (it == r.by_name.end())
+    it = r.by_name.emplace(std::string(name), std::make_unique<capacity_site>(std::string(name))).first;
+  return *it->second;
+}
+} // namespace capacity_site_detail
+
+// Site shared by everything that names the same tag.
+inline capacity_site &capacity_site_for(std::string_view tag) {
+  auto &r = capacity_site_detail::global_registry();
+  const std::lock_guard lock(r.mutex);
+  return capacity_site_detail::find_or_add(r, tag);
+}
+
+// Site for one source location, named "file:line:column". This takes a lock on every call; hot loops should look
+// the site up once and keep the reference, which CAPACITY_SITE_HERE() does.
+inline capacity_site &capacity_site_for(const std::source_location &location) {
+  auto &r = capacity_site_detail::global_registry();
+  const std::lock_guard lock(r.mutex);
+  const auto key = std::make_tuple(location.file_name(), location.line(), location.column());
+  auto it = r.by_location.find(key);
+  if (it == r.by_location.end()) {
+    const std::string name = std::string(location.file_name()) + ":" + std::to_string(location.line()) + ":" +
+                             std::to_string(location.column());
+    it = r.by_location.emplace(key, &capacity_site_detail::find_or_add(r, name)).first;
+  }
+  return *it->second;
+}
+
+// One line per registered site: vectors reported, hit rate, reallocations left and avoided, current suggestion.
+inline void capacity_report(std::ostream &os) {
+  auto &r = capacity_site_detail::global_registry();
+  const std::lock_guard lock(r.mutex);
+  for (const auto &[name, site] : r.by_name) {
+    const capacity_site_stats s = site->stats();
+    os << name << ": " << s.vectors << " vectors, hit rate " << s.hit_rate() * 100 << "%, " << s.reallocations
+       << " reallocations, " << s.reallocations_avoided << " avoided, suggested capacity " << s.suggested_capacity
+       << "\n";
+  }
+}
+
+// The site of the place where the macro is written, looked up on the first use there and kept in a function-local
+// static afterwards, so constructing vectors in a loop costs no lock: my_vector<int> v(CAPACITY_SITE_HERE());
+#define CAPACITY_SITE_HERE()                                                                                           \
+  ([]() -> capacity_site & {                                                                                           \
+    static capacity_site &site = capacity_site_for(std::source_location::current());                                  \
+    return site;                                                                                                       \
+  }())
+
+#endif // CAPACITY_SITE_HPP
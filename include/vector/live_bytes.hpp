@@ -0,0 +1,101 @@
+// This is a personal academic project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++, C#, and Java: http://www.viva64.com
+#ifndef LIVE_BYTES_HPP
+#define LIVE_BYTES_HPP
+
+#include <concurrent/cache_line.hpp>
+#include <atomic>
+#include <cstddef>
+#include <new>
+
+// Bytes of element storage currently held by all my_vector instances of every element type. Every thread counts into
+// a slot of its own, so allocation writes no cache line another thread writes; my_vector_live_bytes() sums the slots
+// on demand. A buffer freed on another thread than the one that allocated it leaves the two slots off by the same
+// amount in opposite directions, which the sum cancels.
+//
+// Slots are never freed. A thread hands its slot back when it exits, with the count still in it, and the next new
+// thread takes it over. Buffers freed after the thread's own thread_local objects are gone (e.g. by static objects
+// at exit) are counted in one shared slot instead.
+namespace live_bytes_detail {
+struct alignas(cache_line_size) slot {
+  std::atomic<std::ptrdiff_t> bytes{0};
+  std::atomic<bool> in_use{true};
+  slot *next = nullptr;
+};
+
+struct registry {
+  std::atomic<slot *> head{nullptr};
+  slot shared;
+};
+
+inline registry &global_registry() {
+  static registry r;
+  return r;
+}
+
+// Trivially destructible, so it stays usable while the thread's other thread_local objects are destroyed.
+inline thread_local slot *local_slot = nullptr;
+inline thread_local bool exited = false;
+
+// Returns the slot of an exiting thread to the registry.
+struct slot_release {
+  slot *owned = nullptr;
+
+  ~slot_release() {
+    exited = true;
+    local_slot = nullptr;
+    if (owned)
+      owned->in_use.store(false, std::memory_order_release);
+  }
+};
+
+inline slot *acquire_slot() noexcept {
+  registry &r = global_registry();
+  for (slot *s = r.head.load(std::memory_order_acquire); s; s = s->next) {
+    bool expected = false;
+    if (!s->in_use.load(std::memory_order_relaxed) &&
+        s->in_use.compare_exchange_strong(expected, true, std::memory_order_acquire))
+      return s;
+  }
+  slot *s = new (std::nothrow) slot;
+  if (!s)
+    return nullptr;
+  s->next = r.head.load(std::memory_order_relaxed);
+  while (!r.head.compare_exchange_weak(s->next, s, std::memory_order_release, std::memory_order_relaxed)) {
+  }
+  return s;
+}
+
+inline void add_slow(std::ptrdiff_t bytes) noexcept {
+  if (!exited) {
+    static thread_local slot_release release;
+    if (slot *s = acquire_slot()) {
+      release.owned = s;
+      local_slot = s;
+      s->bytes.store(s->bytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+      return;
+    }
+  }
+  global_registry().shared.bytes.fetch_add(bytes, std::memory_order_relaxed);
+}
+
+// Only the owning thread writes its slot, so a plain load and store is enough.
+inline void add(std::ptrdiff_t bytes) noexcept {
+  if (slot *s = local_slot) [[likely]] {
+    s->bytes.store(s->bytes.load(std::memory_order_relaxed) + bytes, std::memory_order_relaxed);
+    return;
+  }
+  add_slow(bytes);
+}
+} // namespace live_bytes_detail
+
+// Exact while no other thread allocates or frees; during concurrent activity it may miss the buffers in flight.
+inline std::size_t my_vector_live_bytes() noexcept {
+  live_bytes_detail::registry &r = live_bytes_detail::global_registry();
+  std::ptrdiff_t total = r.shared.bytes.load(std::memory_order_relaxed);
+  for (live_bytes_detail::slot *s = r.head.load(std::memory_order_acquire); s; s = s->next)
+    total += s->bytes.load(std::memory_order_relaxed);
+  return static_cast<std::size_t>(total);
+}
+
+#endif // LIVE_BYTES_HPP
@@ -3,17 +3,78 @@
 #ifndef MY_VECTOR_HPP
 #define MY_VECTOR_HPP
 
+#include <parallel/first_touch.hpp>
+#include <span/my_span.hpp>
+#include <vector/buffer_cache.hpp>
+#include <vector/capacity_site.hpp>
+#include <vector/live_bytes.hpp>
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <stdexcept>
 #include <type_traits>
+#include <utility>
+
+namespace my_vector_detail {
+inline void operator_delete(void *p, std::size_t) noexcept { ::operator delete(p); }
+
+// The capacity sites of the vectors that learn their capacity, by vector address. Such a vector holds site_bound in
+// its deallocator slot and its real deallocator here, so vectors without a site pay no space for the feature.
+struct site_binding {
+  capacity_site *site;
+  void (*deallocate)(void *, std::size_t);
+  bool reallocated; // since the vector last reported to its site
+};
+
+struct site_bindings {
+  std::mutex mutex;
+  std::map<const void *, site_binding> by_vector;
+};
+
+inline site_bindings &global_site_bindings() {
+  static site_bindings bindings;
+  return bindings;
+}
+
+// Marks vectors with an entry in global_site_bindings(); never called.
+inline void site_bound(void *, std::size_t) noexcept {}
+} // namespace my_vector_detail
+
+// Storage handed out by my_vector::release(). The caller owns the size constructed elements and frees the
+// buffer with deallocate(data, capacity * sizeof(T)) after destroying them.
+template <typename T> struct my_vector_buffer {
+  T *data;
+  std::size_t size;
+  std::size_t capacity;
+  void (*deallocate)(void *, std::size_t);
+};
 
 template <typename T> class my_vector {
 public:
+  // Receives the buffer pointer and its size in bytes.
+  using deallocator_type = void (*)(void *, std::size_t);
+
   my_vector() {
-    _start = static_cast<T *>(::operator new(sizeof(T)));
-    _finish = _start;
-    _end_of_storage = _start + 1;
+    T *raw = allocate(1);
+    install_storage(raw, raw, 1);
+  }
+
+  // Starts at the capacity learned by site and reports its final size back to it on destruction, clear() and
+  // release(); see vector/capacity_site.hpp. The site stays with the vector object and follows it on moves, but is
+  // not copied and not exchanged by swap(). For the site of the calling code: my_vector<int> v(CAPACITY_SITE_HERE());
+  // The site is kept outside the object, in a table every reallocation, clear and destruction of the vector looks
+  // up under a lock; that is the price of learning, which pays off when those reallocations stop happening.
+  explicit my_vector(capacity_site &site) {
+    allocate_storage(std::max<size_t>(1, site.suggested_capacity()));
+    try {
+      bind_site(site);
+    } catch (...) {
+      clean_up();
+      throw;
+    }
   }
 
   explicit my_vector(const size_t n) {
@@ -22,6 +83,28 @@ public:
 
   explicit my_vector(const size_t n, const T &value) { allocate_and_fill(n, value); }
 
+  // Same as the two constructors above, but the elements are constructed in parallel chunks with the given NUMA
+  // placement, see parallel/first_touch.hpp. Large buffers with an explicit placement get pages of their own; growth
+  // through the other members later moves the elements to ordinary storage.
+  my_vector(const size_t n, const parallel_init &init) {
+    allocate_placed_storage(n, init);
+    storage_guard guard(_start, n, _deallocate);
+    parallel_uninitialized_construct(_start, n, init,
+                                     [](T *first, size_t count) { std::uninitialized_value_construct_n(first, count); });
+    guard.release();
+    _finish = _end_of_storage;
+  }
+
+  my_vector(const size_t n, const T &value, const parallel_init &init) {
+    allocate_placed_storage(n, init);
+    storage_guard guard(_start, n, _deallocate);
+    parallel_uninitialized_construct(_start, n, init, [&value](T *first, size_t count) {
+      std::uninitialized_fill_n(first, count, value);
+    });
+    guard.release();
+    _finish = _end_of_storage;
+  }
+
   template <std::forward_iterator II>
     requires std::constructible_from<T, std::iter_reference_t<II>>
   my_vector(II first, II last) {
@@ -38,22 +121,24 @@ public:
     _finish = _start + n;
   }
 
+  // The copy is sized to the source's elements, not to its capacity.
   my_vector(const my_vector &other) {
-    size_t n = other.capacity();
-    T *raw = static_cast<T *>(::operator new(n * sizeof(T)));
-    std::unique_ptr<T, void (*)(void *)> guard(raw, ::operator delete);
+    size_t n = other.size();
+    T *raw = allocate(n);
+    storage_guard guard(raw, n);
     T *m = std::uninitialized_copy(other._start, other._finish, raw);
     guard.release();
-    _start = raw;
-    _finish = m;
-    _end_of_storage = _start + n;
+    install_storage(raw, m, n);
   }
 
   my_vector(my_vector &&other) noexcept
-      : _start(other._start), _finish(other._finish), _end_of_storage(other._end_of_storage) {
+      : _start(other._start), _finish(other._finish), _end_of_storage(other._end_of_storage),
+        _deallocate(other._deallocate) {
+    take_site_from(other);
     other._start = nullptr;
     other._finish = nullptr;
     other._end_of_storage = nullptr;
+    other._deallocate = nullptr;
   }
 
   my_vector &operator=(const my_vector &other) {
@@ -66,18 +151,27 @@ public:
 
   my_vector &operator=(my_vector &&other) noexcept {
     if (this != &other) {
+      record_capacity_use();
       clean_up();
+      unbind_site();
       _start = other._start;
       _finish = other._finish;
       _end_of_storage = other._end_of_storage;
+      _deallocate = other._deallocate;
+      take_site_from(other);
       other._start = nullptr;
       other._finish = nullptr;
       other._end_of_storage = nullptr;
+      other._deallocate = nullptr;
     }
     return *this;
   }
 
-  ~my_vector() noexcept { clean_up(); }
+  ~my_vector() noexcept {
+    record_capacity_use();
+    clean_up();
+    unbind_site();
+  }
 
   T &operator[](size_t index) noexcept { return _start[index]; }
 
@@ -103,6 +197,14 @@ public:
 
   const T &back() const { return *(_finish - 1); }
 
+  T *data() noexcept { return _start; }
+
+  const T *data() const noexcept { return _start; }
+
+  operator my_span<T>() noexcept { return my_span<T>(_start, _finish); }
+
+  operator my_span<const T>() const noexcept { return my_span<const T>(_start, _finish); }
+
   T *begin() noexcept { return _start; }
 
   const T *begin() const noexcept { return _start; }
@@ -131,20 +233,24 @@ public:
 
   size_t size() const { return _finish - _start; }
 
+  // Heap bytes owned by this vector's element storage.
+  size_t memory_usage() const noexcept { return (_end_of_storage - _start) * sizeof(T); }
+
+  // Allocated but unused bytes, i.e. what shrink_to_fit would give back.
+  size_t slack_bytes() const noexcept { return (_end_of_storage - _finish) * sizeof(T); }
+
   bool is_empty() const noexcept { return _start == _finish; }
 
   void reserve(size_t n) {
     if (n <= capacity())
       return;
-    T *raw = static_cast<T *>(::operator new(n * sizeof(T)));
-    std::unique_ptr<T, void (*)(void *)> guard(raw, ::operator delete);
+    note_growth();
+    T *raw = allocate(n);
+    storage_guard guard(raw, n);
     T *mid = std::uninitialized_move(_start, _finish, raw);
     guard.release();
-    std::destroy(_start, _finish);
-    ::operator delete(_start);
-    _start = raw;
-    _finish = mid;
-    _end_of_storage = _start + n;
+    clean_up();
+    install_storage(raw, mid, n);
   }
 
   void resize(size_t n) {
@@ -160,15 +266,38 @@ public:
     }
   }
 
+  // Grows with the new elements value-constructed in parallel, into storage placed like the parallel constructors'
+  // when the capacity does not suffice; shrinking behaves like resize(n).
+  void resize(size_t n, const parallel_init &init) {
+    if (n <= size()) {
+      resize(n);
+      return;
+    }
+    if (n > capacity()) {
+      note_growth();
+      deallocator_type deallocator;
+      T *raw = allocate_placed(n, init, deallocator);
+      storage_guard guard(raw, n, deallocator);
+      T *mid = std::uninitialized_move(_start, _finish, raw);
+      guard.release();
+      clean_up();
+      install_storage(raw, mid, n, deallocator);
+    }
+    parallel_uninitialized_construct(_finish, n - size(), init, [](T *first, size_t count) {
+      std::uninitialized_value_construct_n(first, count);
+    });
+    _finish = _start + n;
+  }
+
   void shrink_to_fit() {
     if (_finish < _end_of_storage) {
       size_t new_capacity = size();
-      T *new_start = static_cast<T *>(::operator new(new_capacity * sizeof(T)));
-      T *new_finish = std::uninitialized_copy(_start, _finish, new_start);
+      T *new_start = allocate(new_capacity);
+      storage_guard guard(new_start, new_capacity);
+      T *new_finish = std::uninitialized_move(_start, _finish, new_start);
+      guard.release();
       clean_up();
-      _start = new_start;
-      _finish = new_finish;
-      _end_of_storage = _start + new_capacity;
+      install_storage(new_start, new_finish, new_capacity);
     }
   }
 
@@ -176,35 +305,68 @@ public:
     std::swap(_start, other._start);
     std::swap(_finish, other._finish);
     std::swap(_end_of_storage, other._end_of_storage);
+    if (has_site() || other.has_site()) {
+      const deallocator_type mine = storage_deallocator();
+      set_deallocator(other.storage_deallocator());
+      other.set_deallocator(mine);
+    } else {
+      std::swap(_deallocate, other._deallocate);
+    }
+  }
+
+  // Takes ownership of an external buffer holding size constructed elements, without copying. The buffer is later
+  // freed with deallocator(ptr, capacity * sizeof(T)), or with ::operator delete when deallocator is null. Growth
+  // moves the elements into my_vector's own storage and frees the adopted buffer right away.
+  void adopt(T *ptr, size_t size, size_t capacity, deallocator_type deallocator) noexcept {
+    record_capacity_use();
+    clean_up();
+    _start = ptr;
+    _finish = ptr + size;
+    _end_of_storage = ptr + capacity;
+    set_deallocator(deallocator);
+    live_bytes_detail::add(static_cast<std::ptrdiff_t>(capacity * sizeof(T)));
+  }
+
+  // Gives up the storage without touching the elements; the vector is left empty and unallocated.
+  my_vector_buffer<T> release() noexcept {
+    record_capacity_use();
+    const deallocator_type deallocator = storage_deallocator();
+    my_vector_buffer<T> buffer{_start, size(), capacity(),
+                               deallocator ? deallocator : &my_vector_detail::operator_delete};
+    live_bytes_detail::add(-static_cast<std::ptrdiff_t>(capacity() * sizeof(T)));
+    _start = nullptr;
+    _finish = nullptr;
+    _end_of_storage = nullptr;
+    set_deallocator(nullptr);
+    return buffer;
   }
 
   T *insert(const T *pos, const T &value) {
     const size_t idx = pos - _start;
-    if (_start == _finish) {
-      std::construct_at(_start, value);
-      _finish = _start + 1;
-      return _start;
-    }
     if (_finish < _end_of_storage) {
+      if (_start + idx == _finish) {
+        std::construct_at(_finish, value);
+        ++_finish;
+        return _start + idx;
+      }
+      T copy(value);
       std::uninitialized_move(_finish - 1, _finish, _finish);
       std::move_backward(_start + idx, _finish - 1, _finish);
-      std::construct_at(_start + idx, value);
+      _start[idx] = std::move(copy);
       ++_finish;
       return _start + idx;
     }
     const size_t old_size = size();
     const size_t new_cap = old_size ? old_size * 2 : 1;
-    T *new_start = static_cast<T *>(::operator new(new_cap * sizeof(T)));
+    note_growth();
+    T *new_start = allocate(new_cap);
     T *new_finish = new_start;
     new_finish = std::uninitialized_move(_start, _start + idx, new_start);
     std::construct_at(new_finish, value);
     ++new_finish;
     new_finish = std::uninitialized_move(_start + idx, _finish, new_finish);
-    std::destroy(_start, _finish);
-    ::operator delete(_start);
-    _start = new_start;
-    _finish = new_finish;
-    _end_of_storage = new_start + new_cap;
+    clean_up();
+    install_storage(new_start, new_finish, new_cap);
 
     return _start + idx;
   }
@@ -218,22 +380,29 @@ public:
       return _start + idx;
     if (size() + count <= capacity()) {
       T *old_end = _finish;
-      std::uninitialized_move(_finish - count, _finish, _finish);
-      std::move_backward(_start + idx, old_end - count, old_end);
-      std::uninitialized_copy(first, last, _start + idx);
+      const size_t elems_after = old_end - (_start + idx);
+      if (elems_after > count) {
+        std::uninitialized_move(old_end - count, old_end, old_end);
+        std::move_backward(_start + idx, old_end - count, old_end);
+        std::copy(first, last, _start + idx);
+      } else {
+        II mid = std::next(first, elems_after);
+        std::uninitialized_copy(mid, last, old_end);
+        std::uninitialized_move(_start + idx, old_end, old_end + (count - elems_after));
+        std::copy(first, mid, _start + idx);
+      }
       _finish += count;
       return _start + idx;
     }
     size_t new_cap = std::max(capacity() * 2, size() + count);
-    T *new_start = static_cast<T *>(::operator new(new_cap * sizeof(T)));
+    note_growth();
+    T *new_start = allocate(new_cap);
     T *new_finish = new_start;
     new_finish = std::uninitialized_copy(_start, _start + idx, new_start);
     new_finish = std::uninitialized_copy(first, last, new_finish);
     new_finish = std::uninitialized_copy(_start + idx, _finish, new_finish);
     clean_up();
-    _start = new_start;
-    _finish = new_finish;
-    _end_of_storage = _start + new_cap;
+    install_storage(new_start, new_finish, new_cap);
     return _start + idx;
   }
 
@@ -254,11 +423,84 @@ public:
       std::move(erase_last, _finish, erase_first);
     }
     size_t count = erase_last - erase_first;
+    std::destroy(_finish - count, _finish);
     _finish -= count;
-    std::destroy(erase_first, _finish);
     return erase_first;
   }
 
+  // Moves the last element into pos instead of shifting the tail. O(1), does not preserve order.
+  T *swap_remove(const T *pos) {
+    T *erase_pos = const_cast<T *>(pos);
+    if (erase_pos + 1 != _finish) {
+      *erase_pos = std::move(*(_finish - 1));
+    }
+    --_finish;
+    std::destroy_at(_finish);
+    return erase_pos;
+  }
+
+  // Stable single-pass compaction of the elements for which pred is false; returns the new logical end.
+  // Elements past the returned pointer are moved-from and still alive, as with std::remove_if.
+  template <typename Pred> T *remove_if(Pred pred) {
+    if constexpr (std::is_trivially_copyable_v<T>) {
+      // Branchless: every element is written, the output cursor only advances for kept ones.
+      T *out = _start;
+      for (T *it = _start; it != _finish; ++it) {
+        const bool keep = !pred(std::as_const(*it));
+        *out = *it;
+        out += keep;
+      }
+      return out;
+    } else {
+      return std::remove_if(_start, _finish, pred);
+    }
+  }
+
+  template <typename Pred> size_t erase_if(Pred pred) {
+    T *new_finish = remove_if(pred);
+    const size_t removed = _finish - new_finish;
+    std::destroy(new_finish, _finish);
+    _finish = new_finish;
+    return removed;
+  }
+
+  // Removes the elements at the given ascending indices with one stable compaction pass.
+  // Duplicate indices are ignored; an index past size() throws std::out_of_range before anything is moved.
+  template <std::forward_iterator II>
+    requires std::convertible_to<std::iter_reference_t<II>, size_t>
+  size_t erase_indices(II first, II last) {
+    if (first == last)
+      return 0;
+    const size_t n = size();
+    size_t prev = 0;
+    bool have_prev = false;
+    for (II it = first; it != last; ++it) {
+      const size_t idx = *it;
+      if (idx >= n)
+        throw std::out_of_range("Index out of range");
+      if (have_prev && idx < prev)
+        throw std::invalid_argument("Indices must be sorted");
+      prev = idx;
+      have_prev = true;
+    }
+    T *out = _start + static_cast<size_t>(*first);
+    T *read = out;
+    for (II it = first; it != last; ++it) {
+      T *victim = _start + static_cast<size_t>(*it);
+      if (victim < read)
+        continue;
+      out = std::move(read, victim, out);
+      read = victim + 1;
+    }
+    out = std::move(read, _finish, out);
+    const size_t removed = _finish - out;
+    std::destroy(out, _finish);
+    _finish = out;
+    return removed;
+  }
+
+  size_t erase_indices(std::initializer_list<size_t> indices) { return erase_indices(indices.begin(), indices.end()); }
+
   void pop_back() {
     if (_finish != _start) {
       --_finish;
@@ -274,17 +516,15 @@ public:
     }
     const size_t old_cap = capacity();
     const size_t new_cap = old_cap ? old_cap * 2 : 1;
-    T *new_start = static_cast<T *>(::operator new(new_cap * sizeof(T)));
-    std::unique_ptr<T, void (*)(void *)> guard(new_start, ::operator delete);
+    note_growth();
+    T *new_start = allocate(new_cap);
+    storage_guard guard(new_start, new_cap);
     T *dest = std::uninitialized_move(_start, _finish, new_start);
     std::construct_at(dest, value);
     ++dest;
     guard.release();
-    std::destroy(_start, _finish);
-    ::operator delete(_start);
-    _start = new_start;
-    _finish = dest;
-    _end_of_storage = new_start + new_cap;
+    clean_up();
+    install_storage(new_start, dest, new_cap);
   }
 
   void push_back(T &&value) {
@@ -304,6 +544,7 @@ public:
   }
 
   void clear() noexcept {
+    record_capacity_use();
     std::destroy(_start, _finish);
     _finish = _start;
   }
@@ -328,10 +569,88 @@ public:
   bool operator>=(const my_vector &other) const { return !(*this < other); }
 
 private:
+  // Every buffer goes through allocate/deallocate so that the live-byte count stays exact. With a buffer_cache_scope
+  // open on the calling thread allocate() takes a recycled block; such buffers must carry allocation_deallocator(n)
+  // in _deallocate so that they go back to a cache, which is why they are installed with install_storage(). Freeing
+  // one with deallocate() instead is still correct, it just is not recycled.
+  static T *allocate(const size_t n) {
+    T *p = static_cast<T *>(buffer_cache_allocate(n * sizeof(T)));
+    live_bytes_detail::add(static_cast<std::ptrdiff_t>(n * sizeof(T)));
+    return p;
+  }
+
+  static void deallocate(T *p, const size_t n) noexcept {
+    live_bytes_detail::add(-static_cast<std::ptrdiff_t>(n * sizeof(T)));
+    ::operator delete(p);
+  }
+
+  // Frees a buffer of n elements with its deallocator, or with deallocate() when that is null.
+  static void free_storage(T *p, const size_t n, deallocator_type deallocator) noexcept {
+    if (deallocator) {
+      live_bytes_detail::add(-static_cast<std::ptrdiff_t>(n * sizeof(T)));
+      deallocator(p, n * sizeof(T));
+    } else {
+      deallocate(p, n);
+    }
+  }
+
+  // Frees a freshly allocated buffer if construction into it throws.
+  struct storage_guard {
+    storage_guard(T *p, size_t n, deallocator_type d = nullptr) noexcept : ptr(p), count(n), deallocator(d) {}
+
+    ~storage_guard() {
+      if (ptr)
+        free_storage(ptr, count, deallocator);
+    }
+
+    void release() noexcept { ptr = nullptr; }
+
+    T *ptr;
+    size_t count;
+    deallocator_type deallocator;
+  };
+
+  // Storage for the parallel members: a dedicated mapping that carries init's placement policy when numa_allocate()
+  // provides one, allocate(n) otherwise. Stores the matching deallocator in deallocator.
+  static T *allocate_placed(const size_t n, const parallel_init &init, deallocator_type &deallocator) {
+    if (void *p = numa_allocate(n * sizeof(T), init)) {
+      live_bytes_detail::add(static_cast<std::ptrdiff_t>(n * sizeof(T)));
+      deallocator = &numa_deallocate;
+      return static_cast<T *>(p);
+    }
+    T *raw = allocate(n);
+    deallocator = allocation_deallocator(n);
+    return raw;
+  }
+
+  // Decided per buffer, right after allocate(n) and on the same thread: only blocks the cache rounded up to their
+  // size class may go back to it.
+  static deallocator_type allocation_deallocator(const size_t n) noexcept {
+    return buffer_cache_recyclable(n * sizeof(T)) ? &buffer_cache_deallocate : nullptr;
+  }
+
+  // Takes a buffer of capacity elements, with [start, finish) constructed, that is freed with deallocator.
+  void install_storage(T *start, T *finish, const size_t capacity, deallocator_type deallocator) noexcept {
+    _start = start;
+    _finish = finish;
+    _end_of_storage = start + capacity;
+    set_deallocator(deallocator);
+  }
+
+  // Same for a buffer from allocate(capacity).
+  void install_storage(T *start, T *finish, const size_t capacity) noexcept {
+    install_storage(start, finish, capacity, allocation_deallocator(capacity));
+  }
+
   void allocate_storage(const size_t n) {
-    _start = static_cast<T *>(::operator new(n * sizeof(T)));
-    _end_of_storage = _start + n;
-    _finish = _start;
+    T *raw = allocate(n);
+    install_storage(raw, raw, n);
+  }
+
+  void allocate_placed_storage(const size_t n, const parallel_init &init) {
+    deallocator_type deallocator;
+    T *raw = allocate_placed(n, init, deallocator);
+    install_storage(raw, raw, n, deallocator);
   }
 
   void allocate_and_default_construct(const size_t n) {
@@ -347,24 +666,98 @@ private:
   }
 
   void reallocate(size_t new_cap) {
-    T *new_start = static_cast<T *>(::operator new(new_cap * sizeof(T)));
+    note_growth();
+    T *new_start = allocate(new_cap);
     T *new_finish = std::uninitialized_move(_start, _finish, new_start);
     clean_up();
-    _start = new_start;
-    _finish = new_finish;
-    _end_of_storage = _start + new_cap;
+    install_storage(new_start, new_finish, new_cap);
+  }
+
+  bool has_site() const noexcept { return _deallocate == &my_vector_detail::site_bound; }
+
+  // Calls fn with this vector's entry in the site table, under the table's lock.
+  template <typename F> decltype(auto) with_site(F &&fn) const noexcept {
+    my_vector_detail::site_bindings &bindings = my_vector_detail::global_site_bindings();
+    std::lock_guard<std::mutex> lock(bindings.mutex);
+    return fn(bindings.by_vector.find(this)->second);
+  }
+
+  void bind_site(capacity_site &site) {
+    my_vector_detail::site_bindings &bindings = my_vector_detail::global_site_bindings();
+    std::lock_guard<std::mutex> lock(bindings.mutex);
+    bindings.by_vector.emplace(this, my_vector_detail::site_binding{&site, _deallocate, false});
+    _deallocate = &my_vector_detail::site_bound;
+  }
+
+  // Drops this vector's site entry, if any, keeping the deallocator it held.
+  void unbind_site() noexcept {
+    if (!has_site())
+      return;
+    my_vector_detail::site_bindings &bindings = my_vector_detail::global_site_bindings();
+    std::lock_guard<std::mutex> lock(bindings.mutex);
+    _deallocate = bindings.by_vector.extract(this).mapped().deallocate;
+  }
+
+  // Re-keys other's site entry, if any, to this vector, which must already hold other's deallocator slot.
+  void take_site_from(const my_vector &other) noexcept {
+    if (!other.has_site())
+      return;
+    my_vector_detail::site_bindings &bindings = my_vector_detail::global_site_bindings();
+    std::lock_guard<std::mutex> lock(bindings.mutex);
+    auto node = bindings.by_vector.extract(&other);
+    node.key() = this;
+    bindings.by_vector.insert(std::move(node));
+  }
+
+  // The deallocator of the current buffer, wherever it is kept.
+  deallocator_type storage_deallocator() const noexcept {
+    return has_site() ? with_site([](const my_vector_detail::site_binding &b) { return b.deallocate; }) : _deallocate;
+  }
+
+  void set_deallocator(deallocator_type deallocator) noexcept {
+    if (has_site())
+      with_site([deallocator](my_vector_detail::site_binding &b) { b.deallocate = deallocator; });
+    else
+      _deallocate = deallocator;
   }
 
+  void note_growth() noexcept {
+    if (has_site()) {
+      with_site([](my_vector_detail::site_binding &b) {
+        b.site->note_reallocation();
+        b.reallocated = true;
+      });
+    }
+  }
+
+  void record_capacity_use() noexcept {
+    if (has_site()) {
+      with_site([this](my_vector_detail::site_binding &b) {
+        b.site->record(size(), b.reallocated);
+        b.reallocated = false;
+      });
+    }
+  }
+
+  // Leaves the vector without storage. Every caller that keeps the vector alive installs a new buffer next.
   void clean_up() {
     if (_start) {
       std::destroy(_start, _finish);
-      ::operator delete(_start);
+      free_storage(_start, capacity(), storage_deallocator());
     }
+    set_deallocator(nullptr);
   }
 
   T *_start;
   T *_finish;
   T *_end_of_storage;
+  // Null for buffers from allocate() outside a buffer_cache_scope; set for cached, placed and adopted storage.
+  // my_vector_detail::site_bound for vectors with a capacity site, whose deallocator is in the site table.
+  deallocator_type _deallocate = nullptr;
 };
 
+// Capacity learning and custom deallocators share one slot, so a vector is three pointers and a function pointer.
+static_assert(sizeof(my_vector<int>) == 3 * sizeof(int *) + sizeof(my_vector<int>::deallocator_type),
+              "my_vector must not grow");
+
 #endif // MY_VECTOR_HPP
@@ -1,7 +1,10 @@
 #include <array/my_array.hpp>
+#include <algorithm>
 #include <complex>
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
+#include <type_traits>
 #include <vector>
 
 TEST(MyArrayIntTest, FillConstructorAndAccess) {
@@ -109,3 +112,16 @@ TEST(MyArrayConstexprTest, Constexpr) {
   static_assert(arr[1] == 2, "constexpr operator[] broken");
   static_assert(arr[2] == 3, "constexpr operator[] broken");
 }
+
+TEST(MyArrayIntTest, ParallelFill) {
+  parallel_init init;
+  init.threads = 4;
+  init.min_bytes_per_thread = 1;
+  auto arr = std::make_unique<my_array<int, 1000>>(9, init);
+  EXPECT_TRUE(std::all_of(arr->begin(), arr->end(), [](int x) { return x == 9; }));
+  arr->fill(3, init);
+  EXPECT_EQ(arr->front(), 3);
+  EXPECT_EQ(arr->back(), 3);
+  // Elements that are constructed before the fill would be first touched by the constructing thread.
+  static_assert(!std::is_constructible_v<my_array<std::string, 4>, const std::string &, const parallel_init &>);
+}
@@ -0,0 +1,95 @@
+#include <bit_vector/bit_vector.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <vector>
+
+TEST(BitVectorTest, ConstructAndAccess) {
+  bit_vector bits(130, true);
+  EXPECT_EQ(bits.size(), 130);
+  EXPECT_EQ(bits.words().size(), 3);
+  EXPECT_EQ(bits.count(), 130);
+  EXPECT_TRUE(bits.all());
+  bits[64] = false;
+  EXPECT_FALSE(bits[64]);
+  EXPECT_TRUE(bits.test(65));
+  EXPECT_THROW(bits.at(130), std::out_of_range);
+}
+
+TEST(BitVectorTest, ProxyReference) {
+  bit_vector bits(10);
+  bits[3] = true;
+  bits[4] = bits[3];
+  bits[5].flip();
+  EXPECT_EQ(bits.count(), 3);
+  bool value = bits[4];
+  EXPECT_TRUE(value);
+  bits.reset(4);
+  EXPECT_FALSE(bits[4]);
+}
+
+TEST(BitVectorTest, PushPopResize) {
+  bit_vector bits;
+  for (int i = 0; i < 100; ++i)
+    bits.push_back(i % 3 == 0);
+  EXPECT_EQ(bits.size(), 100);
+  EXPECT_EQ(bits.count(), 34);
+  bits.pop_back();
+  EXPECT_EQ(bits.count(), 33);
+  bits.resize(200, true);
+  EXPECT_EQ(bits.count(), 33 + 101);
+  bits.resize(10);
+  EXPECT_EQ(bits.count(), 4);
+  EXPECT_EQ(bits.words().size(), 1);
+  bits.resize(70);
+  EXPECT_EQ(bits.count(), 4);
+}
+
+TEST(BitVectorTest, FindFirstAndNext) {
+  bit_vector bits(300);
+  EXPECT_EQ(bits.find_first(), bit_vector::npos);
+  std::vector<size_t> positions = {0, 63, 64, 200, 299};
+  for (auto p : positions)
+    bits.set(p);
+  std::vector<size_t> found;
+  for (size_t p = bits.find_first(); p != bit_vector::npos; p = bits.find_next(p))
+    found.push_back(p);
+  EXPECT_EQ(found, positions);
+}
+
+TEST(BitVectorTest, BulkOperations) {
+  bit_vector a(150), b(150);
+  for (size_t i = 0; i < 150; ++i) {
+    a[i] = i % 2 == 0;
+    b[i] = i % 3 == 0;
+  }
+  EXPECT_EQ((a & b).count(), 25);
+  EXPECT_EQ((a | b).count(), 100);
+  EXPECT_EQ((a ^ b).count(), 75);
+  bit_vector c = a;
+  c.and_not(b);
+  EXPECT_EQ(c.count(), 50);
+  bit_vector shorter(10);
+  EXPECT_THROW(a &= shorter, std::invalid_argument);
+}
+
+TEST(BitVectorTest, RankSelect) {
+  bit_vector bits(2000);
+  std::vector<size_t> positions;
+  for (size_t i = 0; i < 2000; i += 7) {
+    if (i < 600 || i > 1500) {
+      bits.set(i);
+      positions.push_back(i);
+    }
+  }
+  rank_select index(bits);
+  size_t expected = 0;
+  for (size_t pos = 0; pos <= 2000; ++pos) {
+    EXPECT_EQ(index.rank1(pos), expected);
+    if (pos < 2000 && bits[pos])
+      ++expected;
+  }
+  for (size_t k = 0; k < positions.size(); ++k)
+    EXPECT_EQ(index.select1(k), positions[k]);
+  EXPECT_EQ(index.select1(positions.size()), bit_vector::npos);
+  EXPECT_EQ(index.rank0(14), 12);
+}
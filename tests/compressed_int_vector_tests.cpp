@@ -0,0 +1,103 @@
+#include <compressed/compressed_int_vector.hpp>
+#include <vector/my_vector.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+
+template <typename Encoding> static void expect_round_trip(const my_vector<uint64_t> &values) {
+  compressed_int_vector<Encoding> c(values.begin(), values.end());
+  ASSERT_EQ(c.size(), values.size());
+  for (size_t i = 0; i < values.size(); ++i)
+    ASSERT_EQ(c[i], values[i]) << i;
+  EXPECT_EQ(c.to_vector(), values);
+  size_t i = 0;
+  c.for_each([&](uint64_t v) { EXPECT_EQ(v, values[i++]); });
+  EXPECT_EQ(i, values.size());
+}
+
+static my_vector<uint64_t> postings(size_t n, uint64_t max_gap) {
+  std::mt19937_64 rng(11);
+  my_vector<uint64_t> v;
+  uint64_t value = 1000;
+  for (size_t i = 0; i < n; ++i) {
+    value += rng() % max_gap;
+    v.push_back(value);
+  }
+  return v;
+}
+
+TEST(CompressedIntVectorTest, EmptyAndPartialBlock) {
+  compressed_int_vector<> c;
+  EXPECT_TRUE(c.is_empty());
+  EXPECT_EQ(c.block_count(), 0);
+  c.push_back(5);
+  c.push_back(3);
+  EXPECT_EQ(c.size(), 2);
+  EXPECT_EQ(c.block_count(), 1);
+  EXPECT_EQ(c[1], 3);
+  EXPECT_EQ(c.back(), 3);
+  EXPECT_THROW(c.at(2), std::out_of_range);
+  EXPECT_TRUE(c.words().is_empty());
+}
+
+TEST(CompressedIntVectorTest, FrameOfReferenceRoundTrip) {
+  expect_round_trip<for_encoding>(postings(1000, 100));
+  expect_round_trip<for_encoding>(my_vector<uint64_t>(300, 42));
+
+  std::mt19937_64 rng(5);
+  my_vector<uint64_t> wide;
+  for (size_t i = 0; i < 515; ++i)
+    wide.push_back(rng() >> (i % 64));
+  wide[7] = 0;
+  wide[8] = ~uint64_t{0};
+  expect_round_trip<for_encoding>(wide);
+}
+
+TEST(CompressedIntVectorTest, DeltaVarintRoundTrip) {
+  expect_round_trip<delta_varint_encoding>(postings(1000, 300));
+  // Decreasing steps wrap around and still decode exactly.
+  my_vector<uint64_t> mixed = {10, 5, ~uint64_t{0}, 0, 1ULL << 63, 7};
+  for (size_t i = 0; i < 200; ++i)
+    mixed.push_back(i * 1'000'000'007ULL);
+  expect_round_trip<delta_varint_encoding>(mixed);
+}
+
+TEST(CompressedIntVectorTest, CompressesSmallGaps) {
+  const auto values = postings(100'000, 16);
+  compressed_int_vector<for_encoding> packed(values.begin(), values.end());
+  compressed_int_vector<delta_varint_encoding> varint(values.begin(), values.end());
+  packed.shrink_to_fit();
+  varint.shrink_to_fit();
+  // Within a block the values span at most 127 * 15 < 2^11, so FOR needs 11 bits per value; every gap fits in one
+  // varint byte.
+  EXPECT_GT(packed.compression_ratio(), 5.0);
+  EXPECT_GT(varint.compression_ratio(), 7.0);
+}
+
+TEST(CompressedIntVectorTest, DecodeBlock) {
+  const auto values = postings(300, 10);
+  compressed_int_vector<delta_varint_encoding> c(values.begin(), values.end());
+  EXPECT_EQ(c.block_count(), 3);
+  uint64_t out[compressed_int_vector<>::block_size];
+  EXPECT_EQ(c.decode_block(1, out), 128);
+  EXPECT_EQ(out[0], values[128]);
+  EXPECT_EQ(out[127], values[255]);
+  EXPECT_EQ(c.decode_block(2, out), 44);
+  EXPECT_EQ(out[43], values[299]);
+}
+
+TEST(CompressedIntVectorTest, LowerBoundUsesSkipPointers) {
+  const auto values = postings(1000, 50);
+  compressed_int_vector<for_encoding> packed(values.begin(), values.end());
+  compressed_int_vector<delta_varint_encoding> varint(values.begin(), values.end());
+  for (uint64_t probe : {uint64_t{0}, values[0], values[127] + 1, values[128], values[500] - 1, values[999],
+                         values[999] + 1, values[990] + 1}) {
+    const auto expected = static_cast<size_t>(std::lower_bound(values.begin(), values.end(), probe) - values.begin());
+    EXPECT_EQ(packed.lower_bound(probe), expected) << probe;
+    EXPECT_EQ(varint.lower_bound(probe), expected) << probe;
+  }
+  compressed_int_vector<> small = {1, 4, 9};
+  EXPECT_EQ(small.lower_bound(5), 2);
+  EXPECT_EQ(small.lower_bound(10), 3);
+}
@@ -0,0 +1,160 @@
+#include <flat/flat_map.hpp>
+#include <flat/flat_set.hpp>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+template <typename Layout> class FlatSetTest : public ::testing::Test {};
+
+using Layouts = ::testing::Types<sorted_layout, eytzinger_layout>;
+TYPED_TEST_SUITE(FlatSetTest, Layouts);
+
+TYPED_TEST(FlatSetTest, InsertRangeSortsAndDeduplicates) {
+  std::vector<int> input = {5, 1, 4, 1, 3, 5, 2};
+  flat_set<int, std::less<int>, TypeParam> s(input.begin(), input.end());
+  EXPECT_EQ(s.size(), 5);
+  EXPECT_EQ(s.keys(), my_vector<int>({1, 2, 3, 4, 5}));
+}
+
+TYPED_TEST(FlatSetTest, FindAndLowerBound) {
+  flat_set<int, std::less<int>, TypeParam> s;
+  for (int i = 0; i < 100; ++i)
+    s.insert(i * 2);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_TRUE(s.contains(i * 2));
+    EXPECT_FALSE(s.contains(i * 2 + 1));
+    if (i + 1 < 100) {
+      EXPECT_EQ(*s.lower_bound(i * 2 + 1), i * 2 + 2);
+    }
+  }
+  EXPECT_EQ(s.lower_bound(-5), s.begin());
+  EXPECT_EQ(s.lower_bound(199), s.end());
+  EXPECT_EQ(s.find(7), s.end());
+}
+
+TYPED_TEST(FlatSetTest, InsertAndErase) {
+  flat_set<int, std::less<int>, TypeParam> s = {3, 1, 2};
+  EXPECT_FALSE(s.insert(2).second);
+  auto [it, inserted] = s.insert(0);
+  EXPECT_TRUE(inserted);
+  EXPECT_EQ(*it, 0);
+  EXPECT_EQ(s.erase(1), 1);
+  EXPECT_EQ(s.erase(1), 0);
+  EXPECT_EQ(s.keys(), my_vector<int>({0, 2, 3}));
+  EXPECT_TRUE(s.contains(3));
+  s.clear();
+  EXPECT_TRUE(s.is_empty());
+  EXPECT_FALSE(s.contains(3));
+}
+
+TEST(FlatSetTest, EytzingerRebuildsAreBatched) {
+  using index_type = eytzinger_layout::index<int, std::less<int>>;
+  my_vector<int> keys;
+  for (int i = 0; i < 80; ++i)
+    keys.push_back(i * 2);
+  index_type index;
+  index.rebuild(keys);
+  EXPECT_FALSE(index.is_stale());
+  // Single-key updates are batched until they reach about an eighth of the size; lookups in between search the key
+  // column.
+  size_t updates = 0;
+  for (int key = 1; index.is_stale() || updates == 0; key += 4) {
+    keys.insert(std::lower_bound(keys.begin(), keys.end(), key), key);
+    index.update(keys);
+    ++updates;
+    EXPECT_TRUE(index.contains(keys, key, std::less<int>()));
+    EXPECT_EQ(index.lower_bound(keys, key + 1, std::less<int>()),
+              static_cast<size_t>(std::lower_bound(keys.begin(), keys.end(), key + 1) - keys.begin()));
+  }
+  EXPECT_GE(updates, 10);
+  EXPECT_LE(updates, 12);
+  keys.insert(keys.end(), 1000);
+  index.update(keys);
+  EXPECT_TRUE(index.is_stale());
+  index.rebuild(keys);
+  EXPECT_EQ(index.find(keys, 1000, std::less<int>()), keys.size() - 1);
+  EXPECT_EQ(index.find(keys, 3, std::less<int>()), keys.size());
+}
+
+TEST(FlatSetTest, CustomComparator) {
+  flat_set<int, std::greater<int>, eytzinger_layout> s = {1, 3, 2};
+  EXPECT_EQ(s.keys(), my_vector<int>({3, 2, 1}));
+  EXPECT_TRUE(s.contains(2));
+}
+
+TEST(FlatMapTest, InsertRangeKeepsFirstDuplicate) {
+  std::vector<std::pair<int, std::string>> input = {{3, "c"}, {1, "a"}, {3, "x"}, {2, "b"}};
+  flat_map<int, std::string> m(input.begin(), input.end());
+  EXPECT_EQ(m.keys(), my_vector<int>({1, 2, 3}));
+  EXPECT_EQ(m.values(), my_vector<std::string>({"a", "b", "c"}));
+
+  std::vector<std::pair<int, std::string>> more = {{2, "y"}, {0, "z"}};
+  m.insert_range(more.begin(), more.end());
+  EXPECT_EQ(m.keys(), my_vector<int>({0, 1, 2, 3}));
+  EXPECT_EQ(m.at(2), "b");
+  EXPECT_EQ(m.at(0), "z");
+}
+
+TEST(FlatMapTest, AccessAndErase) {
+  flat_map<std::string, int, std::less<std::string>, eytzinger_layout> m = {{"b", 2}, {"a", 1}};
+  EXPECT_EQ(m.at("a"), 1);
+  EXPECT_THROW(m.at("c"), std::out_of_range);
+  m["c"] = 3;
+  EXPECT_EQ(*m.find("c"), 3);
+  EXPECT_EQ(m.find("d"), nullptr);
+  m.insert_or_assign("a", 10);
+  EXPECT_EQ(m.at("a"), 10);
+  EXPECT_FALSE(m.insert("b", 20).second);
+  EXPECT_EQ(m.erase("b"), 1);
+  EXPECT_FALSE(m.contains("b"));
+
+  std::vector<std::string> keys;
+  int sum = 0;
+  for (auto [key, value] : m) {
+    keys.push_back(key);
+    sum += value;
+  }
+  EXPECT_EQ(keys, std::vector<std::string>({"a", "c"}));
+  EXPECT_EQ(sum, 13);
+}
+
+struct throwing_value {
+  static inline bool throw_on_copy = false;
+  int value = 0;
+
+  throwing_value() = default;
+
+  explicit throwing_value(int v) : value(v) {
+    if (v < 0)
+      throw std::runtime_error("construct");
+  }
+
+  throwing_value(const throwing_value &other) : value(other.value) {
+    if (throw_on_copy)
+      throw std::runtime_error("copy");
+  }
+
+  throwing_value &operator=(const throwing_value &) = default;
+};
+
+TEST(FlatMapTest, ThrowingValuesKeepColumnsInStep) {
+  flat_map<int, throwing_value> m;
+  m.try_emplace(1, 10);
+  m.try_emplace(3, 30);
+  EXPECT_THROW(m.try_emplace(2, -1), std::runtime_error);
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_FALSE(m.contains(2));
+
+  throwing_value::throw_on_copy = true;
+  EXPECT_THROW(m.try_emplace(0, 5), std::runtime_error);
+  throwing_value::throw_on_copy = false;
+  EXPECT_EQ(m.size(), 2);
+  EXPECT_FALSE(m.contains(0));
+  EXPECT_EQ(m.at(1).value, 10);
+  EXPECT_EQ(m.at(3).value, 30);
+  EXPECT_EQ(m.erase(1), 1);
+  EXPECT_EQ(m.at(3).value, 30);
+}
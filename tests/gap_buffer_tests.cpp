@@ -0,0 +1,159 @@
+#include <gap_buffer/gap_buffer.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <gtest/gtest.h>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+TEST(GapBufferTest, ConstructionAndAccess) {
+  gap_buffer<int> empty;
+  EXPECT_TRUE(empty.is_empty());
+  EXPECT_EQ(empty.begin(), empty.end());
+
+  gap_buffer<int> b = {1, 2, 3};
+  EXPECT_EQ(b.size(), 3);
+  EXPECT_EQ(b.front(), 1);
+  EXPECT_EQ(b.back(), 3);
+  EXPECT_EQ(b.at(1), 2);
+  EXPECT_THROW(b.at(3), std::out_of_range);
+  EXPECT_EQ(gap_buffer<int>(2, 7), gap_buffer<int>({7, 7}));
+}
+
+TEST(GapBufferTest, InsertAndEraseAroundTheGap) {
+  gap_buffer<char> b = {'a', 'c', 'e'};
+  auto it = b.insert(b.begin() + 1, 'b');
+  EXPECT_EQ(*it, 'b');
+  EXPECT_EQ(b.gap_position(), 2);
+  b.insert(b.begin() + 3, 'd');
+  EXPECT_EQ(b, gap_buffer<char>({'a', 'b', 'c', 'd', 'e'}));
+
+  const std::string word = "xyz";
+  b.insert(b.begin(), word.begin(), word.end());
+  EXPECT_EQ(b.gap_position(), 3);
+  it = b.erase(b.begin() + 1, b.begin() + 3);
+  EXPECT_EQ(*it, 'a');
+  b.erase(b.begin());
+  b.pop_back();
+  b.push_back('!');
+  EXPECT_EQ(b, gap_buffer<char>({'a', 'b', 'c', 'd', '!'}));
+  EXPECT_THROW(b.move_gap(6), std::out_of_range);
+}
+
+TEST(GapBufferTest, InsertingAnElementOfTheSameBuffer) {
+  gap_buffer<std::string> b = {"one", "two"};
+  b.insert(b.begin(), b[1]);
+  b.insert(b.end(), b[0]);
+  EXPECT_EQ(b, gap_buffer<std::string>({"two", "one", "two", "two"}));
+}
+
+TEST(GapBufferTest, InsertingARangeOfTheSameBuffer) {
+  // The source straddles the gap, and the insert both moves the gap and runs out of room.
+  gap_buffer<std::string> b = {"a", "b", "c", "d"};
+  b.move_gap(2);
+  b.shrink_to_fit();
+  b.move_gap(2);
+  b.insert(b.begin() + 3, b.begin(), b.end());
+  EXPECT_EQ(b, gap_buffer<std::string>({"a", "b", "c", "a", "b", "c", "d", "d"}));
+
+  gap_buffer<int> n = {1, 2, 3, 4, 5, 6};
+  n.move_gap(3);
+  const my_span<const int> front = n.before_gap();
+  n.insert(n.end(), front.begin(), front.end());
+  n.insert(n.cbegin(), n.cbegin() + 4, n.cend());
+  EXPECT_EQ(n, gap_buffer<int>({5, 6, 1, 2, 3, 1, 2, 3, 4, 5, 6, 1, 2, 3}));
+}
+
+TEST(GapBufferTest, SegmentsCoverTheSequenceInOrder) {
+  gap_buffer<int> b = {1, 2, 3, 4, 5};
+  b.move_gap(2);
+  EXPECT_EQ(b.before_gap().size(), 2);
+  EXPECT_EQ(b.after_gap().size(), 3);
+  EXPECT_EQ(b.after_gap().front(), 3);
+
+  my_vector<int> seen;
+  size_t segments = 0;
+  b.for_each_segment([&](const int *first, const int *last) {
+    ++segments;
+    seen.insert(seen.end(), first, last);
+  });
+  EXPECT_EQ(segments, 2);
+  EXPECT_EQ(seen, b.to_vector());
+  EXPECT_EQ(seen, (my_vector<int>{1, 2, 3, 4, 5}));
+
+  b.move_gap(0);
+  segments = 0;
+  b.for_each_segment([&](const int *, const int *) { ++segments; });
+  EXPECT_EQ(segments, 1);
+}
+
+TEST(GapBufferTest, ContiguousClosesTheGap) {
+  gap_buffer<int> b = {1, 2, 4};
+  b.insert(b.begin() + 2, 3);
+  my_span<int> all = b.contiguous();
+  EXPECT_EQ(all.size(), 4);
+  EXPECT_EQ(b.gap_position(), 4);
+  EXPECT_TRUE(std::equal(all.begin(), all.end(), b.begin()));
+  all[0] = 10;
+  EXPECT_EQ(b[0], 10);
+  EXPECT_EQ(b.data(), all.data());
+}
+
+TEST(GapBufferTest, LocalEditsDoNotReallocate) {
+  gap_buffer<char32_t> b(1000, U'x');
+  b.reserve(2000);
+  const size_t capacity = b.capacity();
+  for (int i = 0; i < 500; ++i) {
+    b.insert(b.begin() + 400 + i, U'y');
+    if (i % 3 == 0)
+      b.erase(b.begin() + 400 + i);
+  }
+  EXPECT_EQ(b.capacity(), capacity);
+  EXPECT_EQ(std::count(b.begin(), b.end(), U'y'), 333);
+  b.shrink_to_fit();
+  EXPECT_EQ(b.capacity(), b.size());
+  EXPECT_EQ(b.gap_size(), 0);
+}
+
+TEST(GapBufferTest, RandomEditsMatchMyVector) {
+  std::mt19937 rng(5);
+  gap_buffer<int> b;
+  my_vector<int> model;
+  for (int op = 0; op < 5000; ++op) {
+    const size_t pos = model.is_empty() ? 0 : rng() % (model.size() + 1);
+    switch (rng() % 4) {
+    case 0:
+    case 1:
+      b.insert(b.begin() + pos, op);
+      model.insert(model.begin() + pos, op);
+      break;
+    case 2:
+      if (pos < model.size()) {
+        b.erase(b.begin() + pos);
+        model.erase(model.begin() + pos);
+      }
+      break;
+    default: {
+      const int values[] = {op, op + 1, op + 2};
+      b.insert(b.begin() + pos, values, values + 3);
+      model.insert(model.begin() + pos, values, values + 3);
+    }
+    }
+  }
+  ASSERT_EQ(b.size(), model.size());
+  EXPECT_EQ(b.to_vector(), model);
+  EXPECT_TRUE(std::equal(model.begin(), model.end(), b.contiguous().begin()));
+}
+
+TEST(GapBufferTest, ClearAndSwap) {
+  gap_buffer<std::string> a = {"a", "b"};
+  gap_buffer<std::string> b = {"c"};
+  a.swap(b);
+  EXPECT_EQ(a.size(), 1);
+  EXPECT_EQ(b[1], "b");
+  b.clear();
+  EXPECT_TRUE(b.is_empty());
+  EXPECT_GE(b.gap_size(), 2);
+  b.push_back("d");
+  EXPECT_EQ(b.front(), "d");
+}
@@ -0,0 +1,89 @@
+#include <array/my_array.hpp>
+#include <hash/my_hash.hpp>
+#include <vector/my_vector.hpp>
+#include <cstdint>
+#include <gtest/gtest.h>
+#include <set>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+TEST(MyHashTest, HashBytesIsDeterministicAndLengthSensitive) {
+  unsigned char bytes[200];
+  for (size_t i = 0; i < sizeof(bytes); ++i)
+    bytes[i] = static_cast<unsigned char>(i * 7);
+  std::set<uint64_t> seen;
+  for (size_t len = 0; len <= sizeof(bytes); ++len) {
+    EXPECT_EQ(hash_bytes(bytes, len), hash_bytes(bytes, len));
+    seen.insert(hash_bytes(bytes, len));
+  }
+  // Every prefix length, covering all of the short, medium and three-lane paths, hashes differently.
+  EXPECT_EQ(seen.size(), sizeof(bytes) + 1);
+  EXPECT_NE(hash_bytes(bytes, 64, 1), hash_bytes(bytes, 64, 2));
+}
+
+TEST(MyHashTest, SingleBitFlipsChangeTheHash) {
+  for (size_t len : {1, 3, 4, 8, 16, 17, 48, 49, 100}) {
+    my_vector<unsigned char> data(len, 0);
+    const uint64_t base = hash_bytes(data.data(), len);
+    for (size_t bit = 0; bit < len * 8; ++bit) {
+      data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+      EXPECT_NE(hash_bytes(data.data(), len), base) << len << " " << bit;
+      data[bit / 8] ^= static_cast<unsigned char>(1u << (bit % 8));
+    }
+  }
+}
+
+TEST(MyHashTest, TriviallyHashableContainersHashTheirBytes) {
+  static_assert(is_trivially_hashable_v<uint32_t>);
+  static_assert(!is_trivially_hashable_v<float>);
+  static_assert(!is_trivially_hashable_v<std::string>);
+  my_vector<uint32_t> v = {1, 2, 3};
+  EXPECT_EQ(hash_value(v), hash_bytes(v.data(), 3 * sizeof(uint32_t)));
+  EXPECT_EQ(hash_value(my_span<const uint32_t>(v)), hash_value(v));
+  const my_array<uint8_t, 4> a(uint8_t{1}, uint8_t{2}, uint8_t{3}, uint8_t{4});
+  const std::hash<my_array<uint8_t, 4>> hasher;
+  EXPECT_EQ(hasher(a), hash_bytes(a.data(), 4));
+}
+
+TEST(MyHashTest, OtherElementsAreCombinedPerElement) {
+  my_vector<std::string> a = {"ab", "c"};
+  my_vector<std::string> b = {"a", "bc"};
+  EXPECT_EQ(hash_value(a), hash_value(my_vector<std::string>{"ab", "c"}));
+  EXPECT_NE(hash_value(a), hash_value(b));
+  // Equal floating-point values hash equally even when their bytes differ.
+  EXPECT_EQ(hash_value(my_vector<double>{0.0}), hash_value(my_vector<double>{-0.0}));
+}
+
+TEST(MyHashTest, ContainersAsUnorderedMapKeys) {
+  std::unordered_map<my_array<uint8_t, 32>, int> digests;
+  my_array<uint8_t, 32> d1(uint8_t{0});
+  my_array<uint8_t, 32> d2(uint8_t{0});
+  d2[31] = 1;
+  digests[d1] = 1;
+  digests[d2] = 2;
+  EXPECT_EQ(digests.size(), 2);
+  EXPECT_EQ(digests.at(d2), 2);
+
+  std::unordered_map<my_vector<uint32_t>, int> tuples;
+  tuples[{1, 2}] = 12;
+  tuples[{2, 1}] = 21;
+  tuples[{1, 2, 0}] = 120;
+  EXPECT_EQ(tuples.size(), 3);
+  EXPECT_EQ(tuples.at(my_vector<uint32_t>{2, 1}), 21);
+}
+
+TEST(MyHashTest, CachedHash) {
+  using key = cached_hash<my_vector<uint32_t>>;
+  key k(my_vector<uint32_t>{4, 5, 6});
+  EXPECT_EQ(k.hash(), std::hash<my_vector<uint32_t>>()(k.get()));
+  EXPECT_EQ(std::hash<key>()(k), k.hash());
+  EXPECT_EQ(k, key(std::in_place, my_vector<uint32_t>{4, 5, 6}));
+  EXPECT_NE(k, key(my_vector<uint32_t>{4, 5}));
+
+  std::unordered_set<key> set;
+  set.insert(k);
+  set.emplace(my_vector<uint32_t>{7});
+  EXPECT_EQ(set.count(key(my_vector<uint32_t>{4, 5, 6})), 1);
+  EXPECT_EQ(set.count(key(my_vector<uint32_t>{8})), 0);
+}
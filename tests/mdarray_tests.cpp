@@ -0,0 +1,115 @@
+#include <mdarray/md_kernels.hpp>
+#include <mdarray/mdarray.hpp>
+#include <gtest/gtest.h>
+#include <stdexcept>
+
+TEST(MdArrayTest, RowMajorOffsets) {
+  mdarray<int, 3, 4> m;
+  EXPECT_EQ(m.rank(), 2);
+  EXPECT_EQ(m.extent(0), 3);
+  EXPECT_EQ(m.extent(1), 4);
+  EXPECT_EQ(m.size(), 12);
+  for (size_t i = 0; i < 3; ++i) {
+    for (size_t j = 0; j < 4; ++j)
+      m(i, j) = static_cast<int>(i * 10 + j);
+  }
+  EXPECT_EQ(m.data()[1 * 4 + 2], 12);
+  EXPECT_EQ(m.at(2, 3), 23);
+  EXPECT_THROW(m.at(3, 0), std::out_of_range);
+  EXPECT_THROW(m.at(0, 4), std::out_of_range);
+}
+
+TEST(MdArrayTest, ColumnMajorOffsets) {
+  basic_mdarray<int, layout_left, 3, 4> m(0);
+  m(1, 2) = 7;
+  EXPECT_EQ(m.data()[2 * 3 + 1], 7);
+  EXPECT_EQ(m.mapping().stride(0), 1);
+  EXPECT_EQ(m.mapping().stride(1), 3);
+}
+
+TEST(MdArrayTest, ThreeDimensions) {
+  mdarray<int, 2, 3, 4> m(0);
+  m(1, 2, 3) = 5;
+  EXPECT_EQ(m.data()[1 * 12 + 2 * 4 + 3], 5);
+  EXPECT_EQ(m.size(), 24);
+}
+
+TEST(MdArrayTest, BlockedLayoutPadsAndIsBijective) {
+  using blocked = basic_mdarray<int, layout_blocked<4>, 5, 6>;
+  EXPECT_EQ(blocked::required_span_size(), 8 * 8);
+  blocked m(-1);
+  for (size_t i = 0; i < 5; ++i) {
+    for (size_t j = 0; j < 6; ++j)
+      m(i, j) = static_cast<int>(i * 6 + j);
+  }
+  for (size_t i = 0; i < 5; ++i) {
+    for (size_t j = 0; j < 6; ++j)
+      EXPECT_EQ(m(i, j), static_cast<int>(i * 6 + j));
+  }
+  // Element (1, 5) is in the second tile of the first tile row, row 1, column 1.
+  EXPECT_EQ(m.mapping()(1, 5), 16 + 4 + 1);
+}
+
+TEST(MdArrayTest, DynamicExtents) {
+  dynamic_mdarray<double, 2> m(my_array<size_t, 2>(3u, 5u), 1.5);
+  EXPECT_EQ(m.extent(0), 3);
+  EXPECT_EQ(m.extent(1), 5);
+  EXPECT_EQ(m.size(), 15);
+  EXPECT_EQ(m(2, 4), 1.5);
+  m(2, 4) = 2.0;
+  EXPECT_EQ(m.data()[14], 2.0);
+  EXPECT_THROW(m.at(0, 5), std::out_of_range);
+
+  dynamic_mdarray<int, 2, layout_blocked<8>> b(my_array<size_t, 2>(9u, 9u));
+  EXPECT_EQ(b.required_span_size(), 16 * 16);
+}
+
+TEST(MdArrayTest, ViewsAliasStorage) {
+  mdarray<int, 2, 2> m(0);
+  md_view<int, layout_right, 2> v = m;
+  v(1, 0) = 4;
+  EXPECT_EQ(m(1, 0), 4);
+  const auto &cm = m;
+  md_view<const int, layout_right, 2> cv = cm;
+  EXPECT_EQ(cv(1, 0), 4);
+  md_view<const int, layout_right, 2> converted = v;
+  EXPECT_EQ(converted.data_handle(), m.data());
+}
+
+TEST(MdKernelsTest, TransposeAcrossLayouts) {
+  dynamic_mdarray<int, 2> src(my_array<size_t, 2>(37u, 70u));
+  for (size_t i = 0; i < 37; ++i) {
+    for (size_t j = 0; j < 70; ++j)
+      src(i, j) = static_cast<int>(i * 1000 + j);
+  }
+  dynamic_mdarray<int, 2> row(my_array<size_t, 2>(70u, 37u));
+  dynamic_mdarray<int, 2, layout_left> col(my_array<size_t, 2>(70u, 37u));
+  dynamic_mdarray<int, 2, layout_blocked<16>> tiled(my_array<size_t, 2>(70u, 37u));
+  md_transpose<8>(src.view(), row.view());
+  md_transpose(src.view(), col.view());
+  md_transpose(src.view(), tiled.view());
+  for (size_t i = 0; i < 37; ++i) {
+    for (size_t j = 0; j < 70; ++j) {
+      EXPECT_EQ(row(j, i), src(i, j));
+      EXPECT_EQ(col(j, i), src(i, j));
+      EXPECT_EQ(tiled(j, i), src(i, j));
+    }
+  }
+  EXPECT_THROW(md_transpose(src.view(), src.view()), std::invalid_argument);
+}
+
+TEST(MdKernelsTest, CopyConvertsLayout) {
+  mdarray<int, 5, 7> src;
+  for (size_t i = 0; i < 5; ++i) {
+    for (size_t j = 0; j < 7; ++j)
+      src(i, j) = static_cast<int>(i * 7 + j);
+  }
+  basic_mdarray<int, layout_left, 5, 7> col;
+  md_copy(src.view(), col.view());
+  for (size_t i = 0; i < 5; ++i) {
+    for (size_t j = 0; j < 7; ++j)
+      EXPECT_EQ(col(i, j), src(i, j));
+  }
+  basic_mdarray<int, layout_left, 7, 5> wrong;
+  EXPECT_THROW(md_copy(src.view(), wrong.view()), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+#include <concurrent/mpmc_ring.hpp>
+#include <concurrent/spsc_ring.hpp>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(SpscRingTest, PushPopUntilFull) {
+  spsc_ring<std::string, 4> ring;
+  EXPECT_EQ(ring.capacity(), 4);
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(ring.try_push(std::to_string(i)));
+  EXPECT_FALSE(ring.try_push("overflow"));
+  std::string out;
+  EXPECT_TRUE(ring.try_pop(out));
+  EXPECT_EQ(out, "0");
+  EXPECT_TRUE(ring.try_push(std::string("4")));
+  for (int i = 1; i <= 4; ++i) {
+    EXPECT_TRUE(ring.try_pop(out));
+    EXPECT_EQ(out, std::to_string(i));
+  }
+  EXPECT_FALSE(ring.try_pop(out));
+}
+
+TEST(SpscRingTest, BatchOperations) {
+  spsc_ring<int, 8> ring;
+  int in[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  EXPECT_EQ(ring.push_n(in, 10), 8);
+  int out[10] = {};
+  EXPECT_EQ(ring.pop_n(out, 3), 3);
+  EXPECT_EQ(out[2], 2);
+  EXPECT_EQ(ring.push_n(in + 8, 2), 2);
+  EXPECT_EQ(ring.size_approx(), 7);
+  EXPECT_EQ(ring.pop_n(out, 10), 7);
+  EXPECT_EQ(out[0], 3);
+  EXPECT_EQ(out[6], 9);
+}
+
+TEST(SpscRingTest, ConcurrentTransferPreservesOrder) {
+  auto ring = std::make_unique<spsc_ring<int, 64>>();
+  const int total = 100000;
+  std::thread producer([&] {
+    for (int i = 0; i < total;) {
+      if (ring->try_push(i))
+        ++i;
+      else
+        std::this_thread::yield();
+    }
+  });
+  int expected = 0;
+  bool ordered = true;
+  while (expected < total) {
+    int value;
+    if (ring->try_pop(value)) {
+      ordered &= value == expected;
+      ++expected;
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  producer.join();
+  EXPECT_TRUE(ordered);
+}
+
+TEST(MpmcRingTest, SingleThreadedSemantics) {
+  mpmc_ring<int, 4> ring;
+  for (int i = 0; i < 4; ++i)
+    EXPECT_TRUE(ring.try_push(i));
+  EXPECT_FALSE(ring.try_push(4));
+  int value;
+  EXPECT_TRUE(ring.try_pop(value));
+  EXPECT_EQ(value, 0);
+  int batch[4];
+  EXPECT_EQ(ring.pop_n(batch, 4), 3);
+  EXPECT_EQ(batch[2], 3);
+  EXPECT_FALSE(ring.try_pop(value));
+  int in[6] = {10, 11, 12, 13, 14, 15};
+  EXPECT_EQ(ring.push_n(in, 6), 4);
+  EXPECT_EQ(ring.size_approx(), 4);
+}
+
+TEST(MpmcRingTest, ConcurrentProducersAndConsumers) {
+  auto ring = std::make_unique<mpmc_ring<long, 128>>();
+  const long per_producer = 50000;
+  const int producers = 3, consumers = 3;
+  std::atomic<long> sum{0};
+  std::atomic<long> received{0};
+  std::vector<std::thread> threads;
+  for (int p = 0; p < producers; ++p) {
+    threads.emplace_back([&, p] {
+      long batch[8];
+      for (long i = 0; i < per_producer;) {
+        if (p == 0) {
+          const long n = std::min<long>(8, per_producer - i);
+          for (long j = 0; j < n; ++j)
+            batch[j] = i + j + 1;
+          i += ring->push_n(batch, n);
+        } else if (ring->try_push(i + 1)) {
+          ++i;
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (int c = 0; c < consumers; ++c) {
+    threads.emplace_back([&, c] {
+      long batch[8];
+      while (received.load() < producers * per_producer) {
+        if (c == 0) {
+          const size_t n = ring->pop_n(batch, 8);
+          for (size_t j = 0; j < n; ++j)
+            sum += batch[j];
+          received += n;
+        } else {
+          long value;
+          if (ring->try_pop(value)) {
+            sum += value;
+            ++received;
+          }
+        }
+        std::this_thread::yield();
+      }
+    });
+  }
+  for (auto &t : threads)
+    t.join();
+  EXPECT_EQ(received.load(), producers * per_producer);
+  EXPECT_EQ(sum.load(), producers * per_producer * (per_producer + 1) / 2);
+}
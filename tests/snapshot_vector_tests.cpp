@@ -0,0 +1,172 @@
+#include <snapshot/snapshot_vector.hpp>
+#include <atomic>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+TEST(SnapshotVectorTest, SnapshotIsImmutable) {
+  std::vector<int> init = {1, 2, 3, 4, 5};
+  snapshot_vector<int, 2> v(init.begin(), init.end());
+  auto before = v.load();
+  v.update([](auto &w) {
+    w.set(0, 10);
+    w.push_back(6);
+  });
+  auto after = v.load();
+  EXPECT_EQ(before.size(), 5);
+  EXPECT_EQ(before[0], 1);
+  EXPECT_EQ(after.size(), 6);
+  EXPECT_EQ(after[0], 10);
+  EXPECT_EQ(after.at(5), 6);
+  EXPECT_THROW(after.at(6), std::out_of_range);
+}
+
+TEST(SnapshotVectorTest, UnchangedChunksAreShared) {
+  std::vector<int> init(10, 7);
+  snapshot_vector<int, 4> v(init.begin(), init.end());
+  auto before = v.load();
+  v.update([](auto &w) { w.set(9, 1); });
+  auto after = v.load();
+
+  std::vector<const int *> before_chunks, after_chunks;
+  before.for_each_chunk([&](const int *first, const int *) { before_chunks.push_back(first); });
+  after.for_each_chunk([&](const int *first, const int *) { after_chunks.push_back(first); });
+  ASSERT_EQ(before_chunks.size(), 3);
+  ASSERT_EQ(after_chunks.size(), 3);
+  EXPECT_EQ(before_chunks[0], after_chunks[0]);
+  EXPECT_EQ(before_chunks[1], after_chunks[1]);
+  EXPECT_NE(before_chunks[2], after_chunks[2]);
+}
+
+TEST(SnapshotVectorTest, PopBackAndClear) {
+  std::vector<int> init = {1, 2, 3};
+  snapshot_vector<int, 2> v(init.begin(), init.end());
+  v.update([](auto &w) {
+    w.pop_back();
+    w.pop_back();
+  });
+  EXPECT_EQ(v.size(), 1);
+  v.update([](auto &w) { w.clear(); });
+  EXPECT_TRUE(v.load().is_empty());
+}
+
+TEST(SnapshotVectorTest, PopBackDoesNotCloneSharedChunks) {
+  std::vector<int> init = {1, 2, 3, 4, 5, 6};
+  snapshot_vector<int, 4> v(init.begin(), init.end());
+  auto before = v.load();
+  auto chunk_starts = [](const auto &s) {
+    std::vector<const int *> starts;
+    s.for_each_chunk([&](const int *first, const int *) { starts.push_back(first); });
+    return starts;
+  };
+
+  v.update([](auto &w) { w.pop_back(); });
+  auto popped = v.load();
+  EXPECT_EQ(chunk_starts(popped), chunk_starts(before));
+  size_t seen = 0;
+  popped.for_each_chunk([&](const int *first, const int *last) { seen += last - first; });
+  EXPECT_EQ(seen, 5);
+
+  // Writing into the popped chunk clones its live elements once; later pops and pushes reuse the clone.
+  v.update([](auto &w) {
+    w.pop_back();
+    w.push_back(50);
+    w.push_back(60);
+    w.pop_back();
+    w.push_back(70);
+  });
+  auto pushed = v.load();
+  EXPECT_EQ(chunk_starts(pushed)[0], chunk_starts(before)[0]);
+  EXPECT_NE(chunk_starts(pushed)[1], chunk_starts(before)[1]);
+  EXPECT_EQ(pushed.size(), 6);
+  EXPECT_EQ(pushed[4], 50);
+  EXPECT_EQ(pushed[5], 70);
+  EXPECT_EQ(before[4], 5);
+  EXPECT_EQ(before[5], 6);
+  EXPECT_EQ(popped.size(), 5);
+}
+
+TEST(SnapshotVectorTest, ConcurrentReadersSeeConsistentVersions) {
+  std::vector<int> init(1000, 0);
+  snapshot_vector<int, 64> v(init.begin(), init.end());
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 3; ++r) {
+    readers.emplace_back([&] {
+      while (!done.load()) {
+        auto snap = v.load();
+        const int first = snap[0];
+        for (size_t i = 1; i < snap.size(); ++i) {
+          if (snap[i] != first)
+            ++inconsistent;
+        }
+      }
+    });
+  }
+  for (int gen = 1; gen <= 50; ++gen) {
+    v.update([gen](auto &w) {
+      for (size_t i = 0; i < w.size(); ++i)
+        w.set(i, gen);
+    });
+  }
+  done = true;
+  for (auto &t : readers)
+    t.join();
+  EXPECT_EQ(inconsistent.load(), 0);
+  EXPECT_EQ(v.load()[999], 50);
+}
+
+TEST(SnapshotVectorTest, ReadersRaceDirectPublishes) {
+  // Every version holds one value in all slots plus its generation at the end; readers copy and drop snapshots
+  // while the writer publishes as fast as it can, so retired versions are freed under their feet if the epochs
+  // do not hold them.
+  std::vector<int> init(300, 0);
+  snapshot_vector<int, 32> v(init.begin(), init.end());
+  std::atomic<bool> done{false};
+  std::atomic<int> inconsistent{0};
+  std::atomic<int> went_back{0};
+  std::vector<std::thread> readers;
+  for (int r = 0; r < 6; ++r) {
+    readers.emplace_back([&] {
+      int last_seen = 0;
+      while (!done.load()) {
+        auto snap = v.load();
+        auto copy = snap;
+        const int gen = copy[copy.size() - 1];
+        if (gen < last_seen)
+          ++went_back;
+        last_seen = gen;
+        copy.for_each_chunk([&](const int *first, const int *last) {
+          for (; first != last; ++first) {
+            if (*first != gen)
+              ++inconsistent;
+          }
+        });
+      }
+    });
+  }
+  for (int gen = 1; gen <= 2000; ++gen) {
+    auto w = v.begin_write();
+    for (size_t i = 0; i < w.size(); ++i)
+      w.set(i, gen);
+    if (gen % 3 == 0)
+      w.pop_back();
+    else
+      w.push_back(gen);
+    v.publish(std::move(w));
+  }
+  done = true;
+  for (auto &t : readers)
+    t.join();
+  EXPECT_EQ(inconsistent.load(), 0);
+  EXPECT_EQ(went_back.load(), 0);
+  {
+    const auto last = v.load();
+    EXPECT_EQ(last[last.size() - 1], 2000);
+  }
+
+  // With every snapshot gone nothing holds the epoch back.
+  v.reclaim();
+  EXPECT_EQ(v.retired_count(), 0);
+}
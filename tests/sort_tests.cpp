@@ -0,0 +1,162 @@
+#include <sort/radix_sort.hpp>
+#include <vector/my_vector.hpp>
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <gtest/gtest.h>
+#include <random>
+#include <string>
+#include <utility>
+
+template <typename T, typename Gen> static my_vector<T> random_vector(size_t n, Gen gen) {
+  my_vector<T> v;
+  v.reserve(n);
+  std::mt19937_64 rng(42);
+  for (size_t i = 0; i < n; ++i)
+    v.push_back(gen(rng));
+  return v;
+}
+
+template <typename T> static bool same_as_std_sort(my_vector<T> sorted, my_vector<T> original) {
+  std::sort(original.begin(), original.end());
+  return sorted == original;
+}
+
+static parallel_init four_threads() {
+  parallel_init init;
+  init.threads = 4;
+  init.min_bytes_per_thread = 1;
+  return init;
+}
+
+TEST(RadixSortTest, UnsignedKeys) {
+  for (size_t n : {0, 1, 10, 63, 64, 1000, 100000}) {
+    auto v = random_vector<uint64_t>(n, [](auto &rng) { return rng(); });
+    auto sorted = v;
+    radix_sort(sorted);
+    EXPECT_TRUE(same_as_std_sort(sorted, v)) << n;
+  }
+}
+
+TEST(RadixSortTest, SignedAndSmallKeys) {
+  auto ints = random_vector<int32_t>(5000, [](auto &rng) { return static_cast<int32_t>(rng()); });
+  auto sorted_ints = ints;
+  radix_sort(sorted_ints);
+  EXPECT_TRUE(same_as_std_sort(sorted_ints, ints));
+
+  auto bytes = random_vector<int8_t>(5000, [](auto &rng) { return static_cast<int8_t>(rng()); });
+  auto sorted_bytes = bytes;
+  radix_sort(sorted_bytes);
+  EXPECT_TRUE(same_as_std_sort(sorted_bytes, bytes));
+}
+
+TEST(RadixSortTest, FloatingPointKeys) {
+  auto doubles = random_vector<double>(5000, [](auto &rng) {
+    return std::uniform_real_distribution<double>(-1e6, 1e6)(rng);
+  });
+  doubles.push_back(0.0);
+  doubles.push_back(-1e-300);
+  auto sorted = doubles;
+  radix_sort(sorted);
+  EXPECT_TRUE(same_as_std_sort(sorted, doubles));
+
+  my_vector<float> floats = {3.5f, -0.0f, -2.0f, 0.0f, -7.25f, 1e30f, -1e30f};
+  radix_sort(floats);
+  EXPECT_TRUE(std::is_sorted(floats.begin(), floats.end()));
+  EXPECT_TRUE(std::signbit(floats[2]));
+}
+
+TEST(RadixSortTest, IntegerPairs) {
+  auto v = random_vector<std::pair<uint32_t, uint32_t>>(20000, [](auto &rng) {
+    return std::pair<uint32_t, uint32_t>(static_cast<uint32_t>(rng() % 100), static_cast<uint32_t>(rng()));
+  });
+  auto sorted = v;
+  radix_sort(sorted);
+  EXPECT_TRUE(same_as_std_sort(sorted, v));
+}
+
+TEST(RadixSortTest, KeyExtractorIsStable) {
+  struct record {
+    int16_t key;
+    size_t position;
+  };
+  my_vector<record> v;
+  std::mt19937 rng(7);
+  for (size_t i = 0; i < 10000; ++i)
+    v.push_back({static_cast<int16_t>(rng() % 50 - 25), i});
+  auto by_key = [](const record &r) { return r.key; };
+  radix_sort(v, by_key);
+  for (size_t i = 1; i < v.size(); ++i) {
+    ASSERT_LE(v[i - 1].key, v[i].key);
+    if (v[i - 1].key == v[i].key) {
+      ASSERT_LT(v[i - 1].position, v[i].position);
+    }
+  }
+}
+
+TEST(RadixSortTest, ReusesScratchBuffer) {
+  my_vector<uint32_t> scratch;
+  scratch.resize(2000);
+  const uint32_t *buffers[] = {scratch.data(), nullptr};
+  for (int round = 0; round < 4; ++round) {
+    auto v = random_vector<uint32_t>(2000, [round](auto &rng) { return static_cast<uint32_t>(rng() >> round); });
+    buffers[1] = v.data();
+    radix_sort(v, scratch);
+    EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+    // Whichever buffer ends up as scratch is one of the two that existed before the call.
+    EXPECT_TRUE(scratch.data() == buffers[0] || scratch.data() == buffers[1]);
+    buffers[0] = scratch.data();
+  }
+}
+
+TEST(ParallelRadixSortTest, MatchesStdSort) {
+  auto v = random_vector<uint64_t>(200000, [](auto &rng) { return rng(); });
+  auto sorted = v;
+  parallel_radix_sort(sorted, four_threads());
+  EXPECT_TRUE(same_as_std_sort(sorted, v));
+
+  auto pairs = random_vector<std::pair<uint32_t, uint32_t>>(100000, [](auto &rng) {
+    return std::pair<uint32_t, uint32_t>(static_cast<uint32_t>(rng() % 7), static_cast<uint32_t>(rng() % 1000));
+  });
+  auto sorted_pairs = pairs;
+  parallel_radix_sort(sorted_pairs, four_threads());
+  EXPECT_TRUE(same_as_std_sort(sorted_pairs, pairs));
+}
+
+TEST(ParallelRadixSortTest, NarrowAndConstantKeys) {
+  auto narrow = random_vector<int64_t>(50000, [](auto &rng) { return static_cast<int64_t>(rng() % 300) - 150; });
+  auto sorted = narrow;
+  parallel_radix_sort(sorted, four_threads());
+  EXPECT_TRUE(same_as_std_sort(sorted, narrow));
+
+  my_vector<double> same(10000, 2.5);
+  parallel_radix_sort(same, four_threads());
+  EXPECT_TRUE(std::all_of(same.begin(), same.end(), [](double x) { return x == 2.5; }));
+}
+
+TEST(ParallelRadixSortTest, KeyExtractorIsStable) {
+  my_vector<std::pair<float, size_t>> v;
+  std::mt19937 rng(3);
+  for (size_t i = 0; i < 50000; ++i)
+    v.push_back({static_cast<float>(rng() % 1000) / 8.0f - 60.0f, i});
+  my_vector<std::pair<float, size_t>> scratch;
+  parallel_radix_sort(v, scratch, four_threads(), [](const auto &p) { return p.first; });
+  for (size_t i = 1; i < v.size(); ++i) {
+    ASSERT_LE(v[i - 1].first, v[i].first);
+    if (v[i - 1].first == v[i].first) {
+      ASSERT_LT(v[i - 1].second, v[i].second);
+    }
+  }
+}
+
+TEST(AdaptiveSortTest, FallsBackToComparisonSort) {
+  my_vector<std::string> words = {"pear", "apple", "fig", "banana"};
+  adaptive_sort(words);
+  EXPECT_EQ(words, (my_vector<std::string>{"apple", "banana", "fig", "pear"}));
+
+  auto v = random_vector<int>(1000, [](auto &rng) { return static_cast<int>(rng() % 100); });
+  adaptive_sort(v, std::greater<>());
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end(), std::greater<>()));
+  adaptive_sort(v);
+  EXPECT_TRUE(std::is_sorted(v.begin(), v.end()));
+}
@@ -0,0 +1,53 @@
+#include <array/my_array.hpp>
+#include <span/my_span.hpp>
+#include <vector/my_vector.hpp>
+#include <gtest/gtest.h>
+#include <numeric>
+#include <stdexcept>
+
+static int sum(my_span<const int> values) { return std::accumulate(values.begin(), values.end(), 0); }
+
+TEST(MySpanTest, ViewsVectorWithoutCopy) {
+  my_vector<int> v = {1, 2, 3, 4};
+  my_span<int> s = v;
+  EXPECT_EQ(s.data(), v.data());
+  EXPECT_EQ(s.size(), 4);
+  s[0] = 10;
+  EXPECT_EQ(v[0], 10);
+  EXPECT_EQ(sum(v), 19);
+  const my_vector<int> &cv = v;
+  my_span<const int> cs = cv;
+  EXPECT_EQ(cs.back(), 4);
+}
+
+TEST(MySpanTest, ViewsArray) {
+  my_array<int, 3> a(1, 2, 3);
+  my_span<int> s = a;
+  EXPECT_EQ(s.data(), a.data());
+  EXPECT_EQ(sum(a), 6);
+  s.back() = 5;
+  EXPECT_EQ(a[2], 5);
+}
+
+TEST(MySpanTest, Subviews) {
+  my_vector<int> v = {0, 1, 2, 3, 4, 5};
+  my_span<int> s = v;
+  EXPECT_EQ(sum(s.first(2)), 1);
+  EXPECT_EQ(sum(s.last(2)), 9);
+  EXPECT_EQ(sum(s.subspan(1, 3)), 6);
+  EXPECT_EQ(sum(s.subspan(4)), 9);
+  EXPECT_EQ(s.size_bytes(), 6 * sizeof(int));
+  EXPECT_THROW(s.at(6), std::out_of_range);
+  EXPECT_TRUE(my_span<int>().is_empty());
+}
+
+TEST(MySpanTest, PointerAndCountOrPointerPair) {
+  my_vector<int> v = {1, 2, 3};
+  int *p = v.data();
+  const my_span<int> none(p, 0);
+  EXPECT_TRUE(none.is_empty());
+  EXPECT_EQ(none.data(), p);
+  EXPECT_EQ(my_span<int>(p, 2).size(), 2);
+  EXPECT_EQ(sum(my_span<const int>(p, p + 3)), 6);
+  EXPECT_TRUE(my_span<int>(p, p).is_empty());
+}
@@ -1,7 +1,15 @@
 #include <vector/my_vector.hpp>
 #include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
 #include <gtest/gtest.h>
+#include <source_location>
+#include <sstream>
 #include <stdexcept>
+#include <string>
+#include <thread>
 #include <vector>
 
 TEST(MyVectorTest, DefaultConstructor) {
@@ -197,4 +205,489 @@ TEST(MyVectorTest, ComparisonOperators) {
   EXPECT_TRUE(c > a);
   EXPECT_TRUE(a <= b);
   EXPECT_TRUE(a >= b);
-}
\ No newline at end of file
+}
+
+TEST(MyVectorTest, EraseRangeKeepsTailAlive) {
+  my_vector<std::string> v = {"a", "b", "c", "d"};
+  v.erase(v.begin(), v.begin() + 2);
+  EXPECT_EQ(v.size(), 2);
+  EXPECT_EQ(v[0], "c");
+  EXPECT_EQ(v[1], "d");
+}
+
+TEST(MyVectorTest, SwapRemove) {
+  my_vector<int> v = {1, 2, 3, 4};
+  auto it = v.swap_remove(v.begin() + 1);
+  EXPECT_EQ(*it, 4);
+  EXPECT_EQ(v, my_vector<int>({1, 4, 3}));
+  v.swap_remove(v.end() - 1);
+  EXPECT_EQ(v, my_vector<int>({1, 4}));
+}
+
+TEST(MyVectorTest, EraseIf) {
+  my_vector<int> v = {1, 2, 3, 4, 5, 6};
+  EXPECT_EQ(v.erase_if([](int x) { return x % 2 == 0; }), 3);
+  EXPECT_EQ(v, my_vector<int>({1, 3, 5}));
+
+  my_vector<std::string> s = {"keep", "drop", "keep2", "drop"};
+  EXPECT_EQ(s.erase_if([](const std::string &x) { return x == "drop"; }), 2);
+  EXPECT_EQ(s, my_vector<std::string>({"keep", "keep2"}));
+}
+
+TEST(MyVectorTest, RemoveIfLeavesSizeUnchanged) {
+  my_vector<int> v = {5, 1, 5, 2};
+  int *new_end = v.remove_if([](int x) { return x == 5; });
+  EXPECT_EQ(new_end - v.begin(), 2);
+  EXPECT_EQ(v.size(), 4);
+  EXPECT_EQ(v[0], 1);
+  EXPECT_EQ(v[1], 2);
+}
+
+TEST(MyVectorTest, EraseIndices) {
+  my_vector<std::string> v = {"0", "1", "2", "3", "4", "5"};
+  EXPECT_EQ(v.erase_indices({0, 2, 2, 5}), 3);
+  EXPECT_EQ(v, my_vector<std::string>({"1", "3", "4"}));
+
+  std::vector<size_t> none;
+  EXPECT_EQ(v.erase_indices(none.begin(), none.end()), 0);
+  EXPECT_THROW(v.erase_indices({1, 0}), std::invalid_argument);
+  EXPECT_THROW(v.erase_indices({3}), std::out_of_range);
+  EXPECT_EQ(v.size(), 3);
+}
+
+TEST(MyVectorTest, InsertAtEndAndLongRange) {
+  my_vector<std::string> v = {"a", "b"};
+  v.reserve(10);
+  v.insert(v.end(), "c");
+  std::vector<std::string> more = {"x", "y", "z"};
+  v.insert(v.begin() + 1, more.begin(), more.end());
+  EXPECT_EQ(v, my_vector<std::string>({"a", "x", "y", "z", "b", "c"}));
+  v.insert(v.begin() + 5, more.begin(), more.begin() + 1);
+  EXPECT_EQ(v, my_vector<std::string>({"a", "x", "y", "z", "b", "x", "c"}));
+}
+
+TEST(MyVectorTest, CopyIsSizedToElements) {
+  my_vector<int> a;
+  for (int i = 0; i < 9; ++i)
+    a.push_back(i);
+  EXPECT_EQ(a.capacity(), 16);
+  my_vector<int> b(a);
+  EXPECT_EQ(b.capacity(), 9);
+  EXPECT_EQ(b, a);
+  my_vector<int> c;
+  c = a;
+  EXPECT_EQ(c.capacity(), 9);
+}
+
+TEST(MyVectorTest, ShrinkToFitMovesElements) {
+  my_vector<std::string> v;
+  v.reserve(8);
+  v.push_back(std::string(64, 'x'));
+  const char *chars = v[0].data();
+  v.shrink_to_fit();
+  EXPECT_EQ(v.capacity(), 1);
+  EXPECT_EQ(v[0].data(), chars);
+}
+
+TEST(MyVectorTest, MemoryFootprint) {
+  const size_t before = my_vector_live_bytes();
+  {
+    my_vector<int> v;
+    v.reserve(100);
+    v.push_back(1);
+    EXPECT_EQ(v.memory_usage(), 100 * sizeof(int));
+    EXPECT_EQ(v.slack_bytes(), 99 * sizeof(int));
+    EXPECT_EQ(my_vector_live_bytes(), before + 100 * sizeof(int));
+    my_vector<double> d(10);
+    EXPECT_EQ(my_vector_live_bytes(), before + 100 * sizeof(int) + 10 * sizeof(double));
+    v.shrink_to_fit();
+    EXPECT_EQ(v.slack_bytes(), 0);
+    EXPECT_EQ(my_vector_live_bytes(), before + sizeof(int) + 10 * sizeof(double));
+  }
+  EXPECT_EQ(my_vector_live_bytes(), before);
+}
+
+TEST(MyVectorTest, LiveBytesFollowBuffersAcrossThreads) {
+  const size_t before = my_vector_live_bytes();
+  my_vector<int> handed_over;
+  std::thread producer([&] {
+    my_vector<int> local(1000);
+    handed_over = std::move(local);
+    my_vector<int> transient(500);
+  });
+  producer.join();
+  EXPECT_EQ(my_vector_live_bytes(), before + 1000 * sizeof(int));
+  std::thread consumer([&] { my_vector<int>(1).swap(handed_over); });
+  consumer.join();
+  EXPECT_EQ(my_vector_live_bytes(), before + sizeof(int));
+}
+
+static int freed_buffers = 0;
+
+static void counting_free(void *p, size_t) {
+  ++freed_buffers;
+  std::free(p);
+}
+
+TEST(MyVectorTest, AdoptExternalBuffer) {
+  freed_buffers = 0;
+  int *raw = static_cast<int *>(std::malloc(4 * sizeof(int)));
+  for (int i = 0; i < 3; ++i)
+    raw[i] = i + 1;
+  {
+    my_vector<int> v;
+    v.adopt(raw, 3, 4, counting_free);
+    EXPECT_EQ(v.data(), raw);
+    EXPECT_EQ(v, my_vector<int>({1, 2, 3}));
+    v.push_back(4);
+    EXPECT_EQ(v.data(), raw);
+    EXPECT_EQ(freed_buffers, 0);
+    v.push_back(5);
+    EXPECT_NE(v.data(), raw);
+    EXPECT_EQ(freed_buffers, 1);
+    EXPECT_EQ(v, my_vector<int>({1, 2, 3, 4, 5}));
+  }
+  EXPECT_EQ(freed_buffers, 1);
+
+  raw = static_cast<int *>(std::malloc(2 * sizeof(int)));
+  {
+    my_vector<int> v;
+    v.adopt(raw, 0, 2, counting_free);
+    my_vector<int> moved(std::move(v));
+    moved.push_back(7);
+  }
+  EXPECT_EQ(freed_buffers, 2);
+}
+
+TEST(MyVectorTest, ReleaseStorage) {
+  const size_t before = my_vector_live_bytes();
+  my_vector<std::string> v = {"a", "b"};
+  const std::string *data = v.data();
+  my_vector_buffer<std::string> buffer = v.release();
+  EXPECT_EQ(buffer.data, data);
+  EXPECT_EQ(buffer.size, 2);
+  EXPECT_EQ(buffer.capacity, 2);
+  EXPECT_TRUE(v.is_empty());
+  EXPECT_EQ(v.capacity(), 0);
+  EXPECT_EQ(my_vector_live_bytes(), before);
+
+  my_vector<std::string> w;
+  w.adopt(buffer.data, buffer.size, buffer.capacity, buffer.deallocate);
+  EXPECT_EQ(w[1], "b");
+  v.push_back("c");
+  EXPECT_EQ(v.size(), 1);
+}
+
+TEST(MyVectorTest, ParallelConstruction) {
+  parallel_init init;
+  init.threads = 4;
+  init.min_bytes_per_thread = 1;
+  my_vector<int> zeros(1001, init);
+  EXPECT_EQ(zeros.size(), 1001);
+  EXPECT_TRUE(std::all_of(zeros.begin(), zeros.end(), [](int x) { return x == 0; }));
+
+  init.placement = numa_placement::interleave;
+  my_vector<std::string> filled(257, std::string("numa"), init);
+  EXPECT_EQ(filled.size(), 257);
+  EXPECT_TRUE(std::all_of(filled.begin(), filled.end(), [](const std::string &x) { return x == "numa"; }));
+
+  init.placement = numa_placement::bind;
+  filled.resize(600, init);
+  EXPECT_EQ(filled.size(), 600);
+  EXPECT_EQ(filled[256], "numa");
+  EXPECT_TRUE(filled[599].empty());
+  filled.resize(3, init);
+  EXPECT_EQ(filled.size(), 3);
+}
+
+TEST(MyVectorTest, ExplicitPlacementUsesDedicatedPages) {
+  const size_t before = my_vector_live_bytes();
+  parallel_init init;
+  init.threads = 2;
+  init.placement = numa_placement::interleave;
+  init.placement_min_bytes = 1 << 16;
+  {
+    my_vector<uint64_t> placed(1 << 14, uint64_t{7}, init);
+    EXPECT_EQ(placed.back(), 7);
+    EXPECT_EQ(my_vector_live_bytes(), before + (1 << 17));
+#if defined(__linux__)
+    // A mapping of its own, so no policy is set on pages shared with other allocations.
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(placed.data()) % static_cast<uintptr_t>(sysconf(_SC_PAGESIZE)), 0);
+#endif
+    placed.resize(1 << 15, init);
+    EXPECT_EQ(placed[(1 << 14) - 1], 7);
+    EXPECT_EQ(placed.back(), 0);
+    placed.push_back(1);
+    EXPECT_EQ(placed.size(), (1 << 15) + 1);
+  }
+  {
+    // Below the threshold the buffer comes from the usual allocation and is placed by first touch only.
+    my_vector<uint64_t> small(100, uint64_t{1}, init);
+    EXPECT_EQ(small.size(), 100);
+  }
+  EXPECT_EQ(my_vector_live_bytes(), before);
+}
+
+struct throws_on_construct {
+  static inline std::atomic<int> alive{0};
+  static inline std::atomic<int> constructed{0};
+
+  throws_on_construct() {
+    if (constructed++ == 700)
+      throw std::runtime_error("construct");
+    ++alive;
+  }
+
+  ~throws_on_construct() { --alive; }
+};
+
+TEST(MyVectorTest, ParallelConstructionCleansUpOnThrow) {
+  throws_on_construct::alive = 0;
+  throws_on_construct::constructed = 0;
+  const size_t before = my_vector_live_bytes();
+  parallel_init init;
+  init.threads = 3;
+  init.min_bytes_per_thread = 1;
+  EXPECT_THROW(my_vector<throws_on_construct>(1000, init), std::runtime_error);
+  EXPECT_EQ(throws_on_construct::alive.load(), 0);
+  EXPECT_EQ(my_vector_live_bytes(), before);
+}
+
+TEST(MyVectorTest, ParallelChunksCoverRange) {
+  size_t covered = 0;
+  for (size_t chunk = 0; chunk < 7; ++chunk) {
+    auto [begin, end] = parallel_chunk(chunk, 7, 100);
+    EXPECT_EQ(begin, covered);
+    covered = end;
+  }
+  EXPECT_EQ(covered, 100);
+}
+
+TEST(MyVectorTest, LearnsCapacityPerSite) {
+  capacity_site site("learns");
+  for (int round = 0; round < 20; ++round) {
+    my_vector<int> v(site);
+    if (round > 0) {
+      EXPECT_GE(v.capacity(), 100);
+    }
+    for (int i = 0; i < 100; ++i)
+      v.push_back(i);
+  }
+  const capacity_site_stats s = site.stats();
+  EXPECT_EQ(s.vectors, 20);
+  EXPECT_EQ(s.hits, 19);
+  EXPECT_EQ(s.suggested_capacity, 100);
+  // A plain vector doubles 7 times on the way to 100 elements; only the first round here did.
+  EXPECT_EQ(s.reallocations, 7);
+  EXPECT_EQ(s.reallocations_avoided, 19 * 7);
+}
+
+TEST(MyVectorTest, CapacitySiteIgnoresOutliers) {
+  capacity_site site;
+  for (int round = 0; round < 19; ++round) {
+    my_vector<int> v(site);
+    v.resize(10);
+  }
+  {
+    my_vector<int> v(site);
+    v.resize(100000);
+  }
+  EXPECT_EQ(site.suggested_capacity(), 10);
+}
+
+TEST(MyVectorTest, CapacitySiteReportsOnClearAndMove) {
+  capacity_site site;
+  my_vector<int> v(site);
+  v.resize(5);
+  v.clear();
+  EXPECT_EQ(site.stats().vectors, 1);
+  v.resize(8);
+  {
+    my_vector<int> moved(std::move(v));
+    EXPECT_EQ(site.stats().vectors, 1);
+  }
+  EXPECT_EQ(site.stats().vectors, 2);
+  EXPECT_EQ(site.suggested_capacity(), 8);
+  my_vector<int> copy(site);
+  copy.push_back(1);
+  my_vector<int> plain(copy);
+  plain.resize(1000);
+  plain.clear();
+  EXPECT_EQ(site.stats().vectors, 2);
+}
+
+TEST(MyVectorTest, CapacitySiteSurvivesSwapAndCachedStorage) {
+  static_assert(sizeof(my_vector<int>) == 4 * sizeof(void *));
+  const size_t before = my_vector_live_bytes();
+  capacity_site site;
+  {
+    buffer_cache_scope scope;
+    my_vector<int> learning(site);
+    my_vector<int> plain(64);
+    learning.resize(3);
+    learning.swap(plain);
+    EXPECT_EQ(learning.size(), 64);
+    plain.push_back(1);
+    plain.swap(learning);
+    EXPECT_EQ(learning.size(), 4);
+    my_vector<int> other(site);
+    other.resize(20);
+    other = std::move(learning);
+    EXPECT_EQ(site.stats().vectors, 1);
+  }
+  // other reported its own 20 elements when assigned to and learning's 4 at the end; plain never had the site.
+  EXPECT_EQ(site.stats().vectors, 2);
+  EXPECT_EQ(site.suggested_capacity(), 20);
+  EXPECT_EQ(my_vector_live_bytes(), before);
+}
+
+TEST(MyVectorTest, CapacitySiteFromSourceLocation) {
+  for (int round = 0; round < 3; ++round) {
+    my_vector<int> v(CAPACITY_SITE_HERE());
+    EXPECT_EQ(v.capacity(), round == 0 ? 1 : 40);
+    v.resize(40);
+  }
+  EXPECT_EQ(&capacity_site_for("tag"), &capacity_site_for("tag"));
+
+  auto make = [] { return my_vector<int>(CAPACITY_SITE_HERE()); };
+  for (int round = 0; round < 3; ++round) {
+    my_vector<int> v = make();
+    v.resize(33);
+  }
+  std::ostringstream report;
+  capacity_report(report);
+  EXPECT_NE(report.str().find("vector_tests.cpp"), std::string::npos);
+  EXPECT_NE(report.str().find("3 vectors, hit rate 66.6667%"), std::string::npos);
+}
+
+TEST(MyVectorTest, BufferCacheRecyclesStorage) {
+  const size_t before = my_vector_live_bytes();
+  {
+    buffer_cache_scope scope;
+    const int *first = nullptr;
+    {
+      my_vector<int> v(100);
+      first = v.data();
+    }
+    // 400 and 480 bytes are both in the 512-byte size class.
+    my_vector<int> w(120);
+    EXPECT_EQ(w.data(), first);
+    EXPECT_EQ(buffer_cache_thread_stats().hits, 1);
+    EXPECT_EQ(buffer_cache_thread_stats().recycled, 1);
+  }
+  EXPECT_EQ(my_vector_live_bytes(), before);
+  EXPECT_EQ(buffer_cache_thread_stats().hits, 0);
+}
+
+TEST(MyVectorTest, BufferCacheServesGrowth) {
+  buffer_cache_scope scope;
+  buffer_cache_stats after_first;
+  for (int round = 0; round < 2; ++round) {
+    my_vector<int> v;
+    for (int i = 0; i < 1000; ++i)
+      v.push_back(i);
+    EXPECT_EQ(v[999], 999);
+    if (round == 0)
+      after_first = buffer_cache_thread_stats();
+  }
+  const buffer_cache_stats s = buffer_cache_thread_stats();
+  // 11 buffers per round (capacities 1, 2, ..., 1024). The first round already reuses its capacity-1 block for
+  // capacity 4, and the second round finds all of them.
+  EXPECT_EQ(after_first.hits + after_first.misses, 11);
+  EXPECT_EQ(after_first.hits, 1);
+  EXPECT_EQ(s.misses, after_first.misses);
+  EXPECT_EQ(s.hits, after_first.hits + 11);
+}
+
+TEST(MyVectorTest, BufferCacheIsBounded) {
+  buffer_cache_limits limits;
+  limits.max_bytes = 1024;
+  limits.max_block_bytes = 4096;
+  buffer_cache_scope scope(limits);
+  {
+    my_vector<char> a(512);
+    my_vector<char> b(512);
+    my_vector<char> c(512);
+    my_vector<char> big(8192);
+  }
+  const buffer_cache_stats s = buffer_cache_thread_stats();
+  EXPECT_EQ(s.recycled, 2);
+  EXPECT_EQ(s.dropped, 1);
+  EXPECT_EQ(s.cached_bytes, 1024);
+  buffer_cache_trim();
+  EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 0);
+}
+
+TEST(MyVectorTest, BufferCacheTrimsIdleClasses) {
+  buffer_cache_limits limits;
+  limits.idle_after = std::chrono::milliseconds(0);
+  buffer_cache_scope scope(limits);
+  { my_vector<char> idle(4000); }
+  // The first clock check still sees the 4096-byte class as used; the second one trims it.
+  for (int i = 0; i < 3000; ++i) {
+    my_vector<char> busy(100);
+  }
+  const buffer_cache_stats s = buffer_cache_thread_stats();
+  EXPECT_EQ(s.trimmed_bytes, 4096);
+  EXPECT_EQ(s.cached_bytes, 128);
+}
+
+TEST(MyVectorTest, BufferCacheIdleHookTrimsWithoutFurtherFrees) {
+  buffer_cache_limits limits;
+  limits.idle_after = std::chrono::milliseconds(0);
+  buffer_cache_scope scope(limits);
+  { my_vector<char> idle(4000); }
+  EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 4096);
+  // The class was used since the scope opened, so only the second check finds it idle.
+  buffer_cache_trim_idle();
+  EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 4096);
+  buffer_cache_trim_idle();
+  EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 0);
+  EXPECT_EQ(buffer_cache_thread_stats().trimmed_bytes, 4096);
+}
+
+TEST(MyVectorTest, BufferCacheTrimsOnTheAllocationPath) {
+  buffer_cache_limits limits;
+  limits.idle_after = std::chrono::milliseconds(0);
+  buffer_cache_scope scope(limits);
+  { my_vector<char> idle(4000); }
+  // Only allocations from here on; none of them goes back to the cache.
+  void *blocks[3000];
+  for (void *&block : blocks)
+    block = buffer_cache_allocate(100);
+  EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 0);
+  for (void *block : blocks)
+    ::operator delete(block);
+}
+
+TEST(MyVectorTest, BufferCacheLimitsMayChangeBetweenAllocationAndFree) {
+  buffer_cache_limits small;
+  small.max_block_bytes = size_t{1} << 20;
+  buffer_cache_limits large;
+  large.max_block_bytes = size_t{4} << 20;
+  my_vector<char> big;
+  {
+    buffer_cache_scope scope(small);
+    big = my_vector<char>(1536 * 1024);
+  }
+  {
+    buffer_cache_scope scope(large);
+    // Allocated at its exact size past the old limit, so it must not land on the 2 MiB free list.
+    big = my_vector<char>();
+    EXPECT_EQ(buffer_cache_thread_stats().recycled, 0);
+    EXPECT_EQ(buffer_cache_thread_stats().cached_bytes, 0);
+    my_vector<char> bigger(2000 * 1024, 'x');
+    EXPECT_EQ(bigger.back(), 'x');
+  }
+}
+
+TEST(MyVectorTest, BufferCacheBlocksCanBeFreedElsewhere) {
+  const size_t before = my_vector_live_bytes();
+  my_vector<std::string> v;
+  {
+    buffer_cache_scope scope;
+    v = my_vector<std::string>(50, "x");
+  }
+  std::thread([moved = std::move(v)]() mutable { moved.clear(); }).join();
+  EXPECT_EQ(my_vector_live_bytes(), before);
+}